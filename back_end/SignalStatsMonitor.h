@@ -0,0 +1,95 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <unordered_map>
+#include "logger.h"
+#include "signals/signal.h"
+#include "signals/SignalKeys.h"
+
+// Publishes every signal's counters to the "Signal Stats" signal once a second, with the publish rate and
+// encoded bandwidth over the last second. Collecting touches every signal, so it only runs while a
+// websocket client watches the stats.
+class SignalStatsMonitor
+{
+public:
+    SignalStatsMonitor()
+        : logger_(initializeLogger("SignalStatsMonitor", spdlog::level::info))
+        , statsSignal_(SignalManager::getInstance().getSignal(SignalKeys::SignalStats))
+        , running_(false)
+    {
+    }
+
+    ~SignalStatsMonitor()
+    {
+        stopMonitoring();
+    }
+
+    void startMonitoring()
+    {
+        if (running_)
+        {
+            return;
+        }
+        running_ = true;
+        monitoringThread_ = std::thread(&SignalStatsMonitor::monitoringLoop, this);
+    }
+
+    void stopMonitoring()
+    {
+        running_ = false;
+        if (monitoringThread_.joinable())
+        {
+            monitoringThread_.join();
+        }
+    }
+
+private:
+    struct Sample
+    {
+        uint64_t publishes = 0;
+        uint64_t encodedBytes = 0;
+    };
+
+    void monitoringLoop()
+    {
+        auto lastSampleTime = std::chrono::steady_clock::now();
+        while (running_)
+        {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+            if (!statsSignal_ || !statsSignal_->hasWebSocketSubscribers())
+            {
+                previous_.clear();
+                continue;
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            const double seconds = std::chrono::duration<double>(now - lastSampleTime).count();
+            lastSampleTime = now;
+
+            std::vector<SignalStatsEntry> stats = SignalManager::getInstance().getStats();
+            for (auto& entry : stats)
+            {
+                // Rates need a previous sample, the first one after a client subscribes reports zero.
+                auto it = previous_.find(entry.name);
+                if (it != previous_.end() && seconds > 0.0)
+                {
+                    entry.publishRateHz = (entry.publishes - it->second.publishes) / seconds;
+                    entry.encodedBytesPerSecond = (entry.encodedBytes - it->second.encodedBytes) / seconds;
+                }
+                previous_[entry.name] = Sample{entry.publishes, entry.encodedBytes};
+            }
+            statsSignal_->setValue(stats);
+        }
+    }
+
+    std::shared_ptr<spdlog::logger> logger_;
+    std::shared_ptr<Signal<std::vector<SignalStatsEntry>>> statsSignal_;
+    std::unordered_map<std::string, Sample> previous_;
+    std::atomic<bool> running_;
+    std::thread monitoringThread_;
+};
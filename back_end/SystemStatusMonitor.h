@@ -8,6 +8,7 @@
 #include <sys/statvfs.h>
 #include "logger.h"
 #include "signals/signal.h"
+#include "signals/SignalKeys.h"
 
 class SystemStatusMonitor
 {
@@ -15,16 +16,16 @@ public:
     SystemStatusMonitor(std::shared_ptr<WebSocketServer> webSocketServer)
         : webSocketServer_(webSocketServer)
         , logger_(initializeLogger("SystemStatusMonitor", spdlog::level::info))
-        , cpuUsageSignal_(std::dynamic_pointer_cast<Signal<std::string>>(SignalManager::getInstance().getSharedSignalByName("CPU Usage")))
-        , memoryUsageSignal_(std::dynamic_pointer_cast<Signal<std::string>>(SignalManager::getInstance().getSharedSignalByName("CPU Memory Usage")))
-        , cpuTempSignal_(std::dynamic_pointer_cast<Signal<std::string>>(SignalManager::getInstance().getSharedSignalByName("CPU Temp")))
-        , gpuTempSignal_(std::dynamic_pointer_cast<Signal<std::string>>(SignalManager::getInstance().getSharedSignalByName("GPU Temp")))
-        , throttleStatusSignal_(std::dynamic_pointer_cast<Signal<std::string>>(SignalManager::getInstance().getSharedSignalByName("Throttle Status")))
-        , netRxSignal_(std::dynamic_pointer_cast<Signal<std::string>>(SignalManager::getInstance().getSharedSignalByName("Network RX")))
-        , netTxSignal_(std::dynamic_pointer_cast<Signal<std::string>>(SignalManager::getInstance().getSharedSignalByName("Network TX")))
-        , diskUsageSignal_(std::dynamic_pointer_cast<Signal<std::string>>(SignalManager::getInstance().getSharedSignalByName("Disk Usage")))
-        , loadAvgSignal_(std::dynamic_pointer_cast<Signal<std::string>>(SignalManager::getInstance().getSharedSignalByName("Load Average")))
-        , uptimeSignal_(std::dynamic_pointer_cast<Signal<std::string>>(SignalManager::getInstance().getSharedSignalByName("Uptime")))
+        , cpuUsageSignal_(SignalManager::getInstance().getSignal(SignalKeys::CPUUsage))
+        , memoryUsageSignal_(SignalManager::getInstance().getSignal(SignalKeys::CPUMemoryUsage))
+        , cpuTempSignal_(SignalManager::getInstance().getSignal(SignalKeys::CPUTemp))
+        , gpuTempSignal_(SignalManager::getInstance().getSignal(SignalKeys::GPUTemp))
+        , throttleStatusSignal_(SignalManager::getInstance().getSignal(SignalKeys::ThrottleStatus))
+        , netRxSignal_(SignalManager::getInstance().getSignal(SignalKeys::NetRX))
+        , netTxSignal_(SignalManager::getInstance().getSignal(SignalKeys::NetTX))
+        , diskUsageSignal_(SignalManager::getInstance().getSignal(SignalKeys::DiskUsage))
+        , loadAvgSignal_(SignalManager::getInstance().getSignal(SignalKeys::LoadAvg))
+        , uptimeSignal_(SignalManager::getInstance().getSignal(SignalKeys::Uptime))
         , running_(false)
     {
         logger_->info("SystemStatusMonitor initialized.");
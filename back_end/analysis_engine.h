@@ -0,0 +1,57 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <string>
+#include <utility>
+#include <iostream>
+#include <stdexcept>
+
+// Which stage publishes the ISO band signals ("FFT Bands", "... Left Channel", "... Right Channel").
+enum class AnalysisEngine
+{
+    FFT,
+    IIRFilterbank
+};
+
+inline std::string to_string(AnalysisEngine engine)
+{
+    switch (engine)
+    {
+        case AnalysisEngine::FFT:           return "FFT";
+        case AnalysisEngine::IIRFilterbank: return "IIR Filterbank";
+        default: throw std::invalid_argument("Unknown AnalysisEngine");
+    }
+}
+
+inline std::ostream& operator<<(std::ostream& os, AnalysisEngine engine)
+{
+    os << to_string(engine);
+    return os;
+}
+
+inline std::istream& operator>>(std::istream& is, AnalysisEngine& engine)
+{
+    std::string token;
+    std::getline(is >> std::ws, token);
+
+    if (token == "FFT")                 engine = AnalysisEngine::FFT;
+    else if (token == "IIR Filterbank") engine = AnalysisEngine::IIRFilterbank;
+    else                                is.setstate(std::ios::failbit);
+
+    return is;
+}
+
+inline constexpr std::array<float, 32> ISO_32_BAND_CENTERS =
+{
+    16, 20, 25, 31.5, 40, 50, 63, 80, 100, 125, 160, 200, 250, 315, 400, 500, 630,
+    800, 1000, 1250, 1600, 2000, 2500, 3150, 4000, 5000, 6300, 8000, 10000, 12500, 16000, 20000
+};
+
+// Band edges halfway between neighbouring centers, the outer bands extend half an octave.
+inline std::pair<float, float> isoBandEdges(size_t band)
+{
+    const float sqrt2 = std::sqrt(2.0f);
+    const float lowerFreq = (band == 0) ? ISO_32_BAND_CENTERS[band] / sqrt2 : (ISO_32_BAND_CENTERS[band - 1] + ISO_32_BAND_CENTERS[band]) / 2.0f;
+    const float upperFreq = (band == ISO_32_BAND_CENTERS.size() - 1) ? ISO_32_BAND_CENTERS[band] * sqrt2 : (ISO_32_BAND_CENTERS[band] + ISO_32_BAND_CENTERS[band + 1]) / 2.0f;
+    return { lowerFreq, upperFreq };
+}
@@ -1,29 +1,33 @@
 #include "FFTAnimation.h"
+#include "../signals/SignalKeys.h"
 
 FFTAnimation::FFTAnimation(PixelGridSignal& grid)
     : PixelGridAnimation(grid, 30)
 {
-    auto leftBase = SignalManager::getInstance().getSharedSignalByName("FFT Bands Left Channel");
-    auto rightBase = SignalManager::getInstance().getSharedSignalByName("FFT Bands Right Channel");
-
-    fftLeft_ = std::dynamic_pointer_cast<Signal<std::vector<float>>>(leftBase);
-    fftRight_ = std::dynamic_pointer_cast<Signal<std::vector<float>>>(rightBase);
+    fftLeft_ = SignalManager::getInstance().getSignal(SignalKeys::FFTBandsLeftChannel);
+    fftRight_ = SignalManager::getInstance().getSignal(SignalKeys::FFTBandsRightChannel);
 
     if (fftLeft_)
     {
         fftLeft_->registerSignalValueCallback([this](const std::vector<float>& value, void*) {
             OnLeftUpdate(value, nullptr);
-        }, this);
+        }, this, CallbackDispatch::LatestValue, "Animation");
     }
 
     if (fftRight_)
     {
         fftRight_->registerSignalValueCallback([this](const std::vector<float>& value, void*) {
             OnRightUpdate(value, nullptr);
-        }, this);
+        }, this, CallbackDispatch::LatestValue, "Animation");
     }
 }
 
+FFTAnimation::~FFTAnimation()
+{
+    if (fftLeft_) fftLeft_->unregisterSignalValueCallbackByArg(this);
+    if (fftRight_) fftRight_->unregisterSignalValueCallbackByArg(this);
+}
+
 void FFTAnimation::OnLeftUpdate(const std::vector<float>& value, void*)
 {
     std::lock_guard<std::mutex> lock(mutex_);
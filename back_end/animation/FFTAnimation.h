@@ -9,7 +9,7 @@ class FFTAnimation : public PixelGridAnimation
 {
 public:
     explicit FFTAnimation(PixelGridSignal& grid);
-    ~FFTAnimation() override = default;
+    ~FFTAnimation() override;
 
 protected:
     void AnimateFrame() override;
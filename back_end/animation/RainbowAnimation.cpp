@@ -1,12 +1,14 @@
 #include "RainbowAnimation.h"
+#include "../signals/SignalKeys.h"
 
 RainbowAnimation::RainbowAnimation(PixelGridSignal& grid)
     : PixelGridAnimation(grid, 100)
-    , leftBinDataSignal_(std::dynamic_pointer_cast<Signal<BinData>>(SignalManager::getInstance().getSharedSignalByName("FFT Bands Left Bin Data")))
-    , rightBinDataSignal_(std::dynamic_pointer_cast<Signal<BinData>>(SignalManager::getInstance().getSharedSignalByName("FFT Bands Right Bin Data")))
-    , colorMappingTypeSignal_(std::dynamic_pointer_cast<Signal<std::string>>(SignalManager::getInstance().getSharedSignalByName("Color Mapping Type")))
+    , leftBinDataSignal_(SignalManager::getInstance().getSignal(SignalKeys::FFTBandsLeftBinData))
+    , rightBinDataSignal_(SignalManager::getInstance().getSignal(SignalKeys::FFTBandsRightBinData))
+    , colorMappingTypeSignal_(SignalManager::getInstance().getSignal(SignalKeys::ColorMappingType))
     , logger_(initializeLogger("Rainbow Animation Logger", spdlog::level::info))
 {   
+    // Bin data arrives on the FFT thread, the animation only needs the latest frame so it never holds that thread up.
     auto leftBinDataSignal = leftBinDataSignal_.lock();
     if (leftBinDataSignal)
     {
@@ -15,7 +17,7 @@ RainbowAnimation::RainbowAnimation(PixelGridSignal& grid)
             std::lock_guard<std::mutex> lock(this->mutex_);
             this->logger_->debug("Left Bin Data Signal Callback.");
             this->leftBinData_ = value;
-        }, this);
+        }, this, CallbackDispatch::LatestValue, "Animation");
     }
     else
     {
@@ -31,7 +33,7 @@ RainbowAnimation::RainbowAnimation(PixelGridSignal& grid)
             std::lock_guard<std::mutex> lock(this->mutex_);
             this->logger_->debug("Right Bin Data Signal Callback.");
             this->rightBinData_ = value;
-        }, this);
+        }, this, CallbackDispatch::LatestValue, "Animation");
     }
     else
     {
@@ -64,6 +66,13 @@ RainbowAnimation::RainbowAnimation(PixelGridSignal& grid)
     }
 }
 
+RainbowAnimation::~RainbowAnimation()
+{
+    if (auto signal = leftBinDataSignal_.lock()) signal->unregisterSignalValueCallbackByArg(this);
+    if (auto signal = rightBinDataSignal_.lock()) signal->unregisterSignalValueCallbackByArg(this);
+    if (auto signal = colorMappingTypeSignal_.lock()) signal->unregisterSignalValueCallbackByArg(this);
+}
+
 void RainbowAnimation::AnimateFrame()
 {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -76,7 +85,7 @@ void RainbowAnimation::AnimateFrame()
 
     // Get bright rainbow color
 
-    RGB color = ColorMapper::normalizedToRGB(leftBinData_.maxBin, leftBinData_.totalBins, normalized, colorMappingType_);
+    RGB color = ColorMapper::normalizedToRGB(leftBinData_.peakBin, leftBinData_.totalBins, normalized, colorMappingType_);
 
     // Scroll all rows down
     for (int y = 0; y < height - 1; ++y)
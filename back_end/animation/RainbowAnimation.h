@@ -10,7 +10,7 @@ class RainbowAnimation : public PixelGridAnimation
 {
 public:
     explicit RainbowAnimation(PixelGridSignal& grid);
-    ~RainbowAnimation() override = default;
+    ~RainbowAnimation() override;
 
 protected:
     void AnimateFrame() override;
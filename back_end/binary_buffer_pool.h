@@ -0,0 +1,68 @@
+#pragma once
+#include <vector>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+// Recycles the byte buffers binary websocket messages are encoded into, so a steady stream of frames
+// reuses the same few allocations. WebSocketMessage hands its buffer back when it is destroyed.
+class BinaryBufferPool
+{
+    public:
+        static constexpr size_t MAX_POOLED_BUFFERS = 64;
+        static constexpr size_t MAX_POOLED_CAPACITY = 1 << 20;
+
+        // Never destroyed. Messages cached in signals release their buffers while the other statics are torn
+        // down at exit, the pool has to outlive all of them.
+        static BinaryBufferPool& getInstance()
+        {
+            static BinaryBufferPool* instance = new BinaryBufferPool();
+            return *instance;
+        }
+
+        // Returns an empty buffer, keeping whatever capacity it had when it was released.
+        std::vector<uint8_t> acquire()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (buffers_.empty())
+            {
+                return {};
+            }
+            std::vector<uint8_t> buffer = std::move(buffers_.back());
+            buffers_.pop_back();
+            return buffer;
+        }
+
+        void release(std::vector<uint8_t>&& buffer)
+        {
+            if (buffer.capacity() == 0 || buffer.capacity() > MAX_POOLED_CAPACITY)
+            {
+                return;
+            }
+            buffer.clear();
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (buffers_.size() < MAX_POOLED_BUFFERS)
+            {
+                buffers_.push_back(std::move(buffer));
+            }
+        }
+
+        // For a buffer that stays alive after sending, e.g. in a signal's cache or history. A small message
+        // in a large pooled buffer is copied into an exact fit and the large buffer goes back to the pool.
+        void trim(std::vector<uint8_t>& buffer)
+        {
+            if (buffer.capacity() <= 2 * buffer.size())
+            {
+                return;
+            }
+            std::vector<uint8_t> fitted(buffer.begin(), buffer.end());
+            buffer.swap(fitted);
+            release(std::move(fitted));
+        }
+
+    private:
+        BinaryBufferPool() = default;
+
+        std::mutex mutex_;
+        std::vector<std::vector<uint8_t>> buffers_;
+};
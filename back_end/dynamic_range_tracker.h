@@ -0,0 +1,92 @@
+#pragma once
+#include <string>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+
+enum class DbRangeMode
+{
+    Manual,
+    Auto
+};
+
+inline std::string to_string(DbRangeMode mode)
+{
+    switch (mode)
+    {
+        case DbRangeMode::Manual: return "Manual";
+        case DbRangeMode::Auto:   return "Auto";
+        default: throw std::invalid_argument("Unknown DbRangeMode");
+    }
+}
+
+inline std::ostream& operator<<(std::ostream& os, DbRangeMode mode)
+{
+    os << to_string(mode);
+    return os;
+}
+
+inline std::istream& operator>>(std::istream& is, DbRangeMode& mode)
+{
+    std::string token;
+    std::getline(is >> std::ws, token);
+
+    if (token == "Manual")    mode = DbRangeMode::Manual;
+    else if (token == "Auto") mode = DbRangeMode::Auto;
+    else                      is.setstate(std::ios::failbit);
+
+    return is;
+}
+
+// Follows the noise floor and peak envelope of a stream of band levels in dB.
+// The floor is a streaming percentile estimate, it falls quickly when the room gets quieter and creeps up slowly,
+// the peak attacks instantly and releases at a fixed rate. Each observation costs one compare and add per level.
+class DynamicRangeTracker
+{
+    public:
+        DynamicRangeTracker( float floorPercentile = 0.1f
+                           , float floorAdaptDbPerSecond = 10.0f
+                           , float peakReleaseDbPerSecond = 3.0f
+                           , float floorMarginDb = 3.0f
+                           , float minimumSpanDb = 20.0f )
+            : floorPercentile_(floorPercentile)
+            , floorAdaptDbPerSecond_(floorAdaptDbPerSecond)
+            , peakReleaseDbPerSecond_(peakReleaseDbPerSecond)
+            , floorMarginDb_(floorMarginDb)
+            , minimumSpanDb_(minimumSpanDb)
+        {
+        }
+
+        void reset(float minDb, float maxDb)
+        {
+            floorDb_ = minDb - floorMarginDb_;
+            peakDb_ = maxDb;
+        }
+
+        void observe(const float* levelsDb, size_t count, float elapsedSeconds)
+        {
+            if (count == 0) return;
+
+            // Stochastic quantile update, it settles where floorPercentile_ of the levels are below the floor.
+            const float step = floorAdaptDbPerSecond_ * elapsedSeconds / count;
+            float framePeak = levelsDb[0];
+            for (size_t i = 0; i < count; ++i)
+            {
+                floorDb_ += levelsDb[i] < floorDb_ ? -(1.0f - floorPercentile_) * step : floorPercentile_ * step;
+                framePeak = std::max(framePeak, levelsDb[i]);
+            }
+            peakDb_ = std::max(framePeak, peakDb_ - peakReleaseDbPerSecond_ * elapsedSeconds);
+        }
+
+        float minDb() const { return floorDb_ + floorMarginDb_; }
+        float maxDb() const { return std::max(peakDb_, minDb() + minimumSpanDb_); }
+
+    private:
+        const float floorPercentile_;
+        const float floorAdaptDbPerSecond_;
+        const float peakReleaseDbPerSecond_;
+        const float floorMarginDb_;
+        const float minimumSpanDb_;
+        float floorDb_ = 0.0f;
+        float peakDb_ = 40.0f;
+};
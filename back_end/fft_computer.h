@@ -4,14 +4,20 @@
 #include <thread>
 #include <atomic>
 #include <mutex>
-#include <queue>
+#include <deque>
+#include <chrono>
 #include <condition_variable>
 #include <array>
+#include <map>
+#include <iterator>
 #include <cmath>
 #include "logger.h"
-#include "kiss_fft.h"
+#include "kiss_fftr.h"
 #include "ring_buffer.h"
+#include "dynamic_range_tracker.h"
+#include "analysis_engine.h"
 #include "signals/IntVectorSignal.h"
+#include "signals/SignalKeys.h"
 #include "websocket_server.h"
 
 
@@ -37,6 +43,78 @@ std::string channelTypeToString(ChannelType channel)
     }
 }
 
+enum class FFTQueueOverflowPolicy
+{
+    DropOldest,     // One packet at a time, every frame published, the oldest packet is dropped when full
+    SkipToLatest,   // One packet at a time, every frame published, a full queue is discarded and analysis restarts
+    BatchCatchUp    // Drains the queue at once and publishes each channel once per batch, drops only at twice the depth
+};
+
+inline std::string to_string(FFTQueueOverflowPolicy policy)
+{
+    switch (policy)
+    {
+        case FFTQueueOverflowPolicy::DropOldest:   return "Drop Oldest";
+        case FFTQueueOverflowPolicy::SkipToLatest: return "Skip To Latest";
+        case FFTQueueOverflowPolicy::BatchCatchUp: return "Batch Catch Up";
+        default: throw std::invalid_argument("Unknown FFTQueueOverflowPolicy");
+    }
+}
+
+inline std::ostream& operator<<(std::ostream& os, FFTQueueOverflowPolicy policy)
+{
+    os << to_string(policy);
+    return os;
+}
+
+inline std::istream& operator>>(std::istream& is, FFTQueueOverflowPolicy& policy)
+{
+    std::string token;
+    std::getline(is >> std::ws, token);
+
+    if (token == "Drop Oldest")         policy = FFTQueueOverflowPolicy::DropOldest;
+    else if (token == "Skip To Latest") policy = FFTQueueOverflowPolicy::SkipToLatest;
+    else if (token == "Batch Catch Up") policy = FFTQueueOverflowPolicy::BatchCatchUp;
+    else                                is.setstate(std::ios::failbit);
+
+    return is;
+}
+
+// How frames computed while the queue is backlogged are merged before they are published, Batch Catch Up only.
+enum class FFTBatchPublishMode
+{
+    Latest,
+    PeakHold
+};
+
+inline std::string to_string(FFTBatchPublishMode mode)
+{
+    switch (mode)
+    {
+        case FFTBatchPublishMode::Latest:   return "Latest";
+        case FFTBatchPublishMode::PeakHold: return "Peak Hold";
+        default: throw std::invalid_argument("Unknown FFTBatchPublishMode");
+    }
+}
+
+inline std::ostream& operator<<(std::ostream& os, FFTBatchPublishMode mode)
+{
+    os << to_string(mode);
+    return os;
+}
+
+inline std::istream& operator>>(std::istream& is, FFTBatchPublishMode& mode)
+{
+    std::string token;
+    std::getline(is >> std::ws, token);
+
+    if (token == "Latest")         mode = FFTBatchPublishMode::Latest;
+    else if (token == "Peak Hold") mode = FFTBatchPublishMode::PeakHold;
+    else                           is.setstate(std::ios::failbit);
+
+    return is;
+}
+
 class FFTComputer
 {
     public:
@@ -46,7 +124,9 @@ class FFTComputer
                    , size_t fft_size
                    , unsigned int sampleRate
                    , int32_t maxValue
-                   , std::shared_ptr<WebSocketServer> webSocketServer)
+                   , std::shared_ptr<WebSocketServer> webSocketServer
+                   , size_t maxQueueDepth = 16
+                   , FFTQueueOverflowPolicy overflowPolicy = FFTQueueOverflowPolicy::DropOldest)
             : name_(name)
             , input_signal_name_(input_signal_name)
             , output_signal_name_(output_signal_name)
@@ -54,32 +134,40 @@ class FFTComputer
             , sampleRate_(sampleRate)
             , maxValue_(maxValue)
             , webSocketServer_(webSocketServer)
+            , maxQueueDepth_(std::max<size_t>(1, maxQueueDepth))
+            , overflowPolicy_(overflowPolicy)
             , stopFlag_(false)
+            , requestedFFTSize_(fft_size)
+            , hopSize_(DEFAULT_HOP_SIZE)
         {
             // Retrieve existing logger_ or create a new one
             logger_ = initializeLogger("FFT Computer", spdlog::level::info);
+            rate_limited_log_ = std::make_shared<RateLimitedLogger>(logger_, std::chrono::seconds(10));
             inputSignal_ = dynamic_cast<Signal<std::vector<int32_t>>*>(SignalManager::getInstance().getSignalByName(input_signal_name_));
             if(!inputSignal_)throw std::runtime_error("Failed to get signal: " + input_signal_name_);
             inputSignalLeftChannel_ = dynamic_cast<Signal<std::vector<int32_t>>*>(SignalManager::getInstance().getSignalByName(input_signal_name_ + " Left Channel"));
             if(!inputSignal_)throw std::runtime_error("Failed to get signal: " + input_signal_name_ + " Left Channel");
             inputSignalRightChannel_ = dynamic_cast<Signal<std::vector<int32_t>>*>(SignalManager::getInstance().getSignalByName(input_signal_name_ + " Right Channel"));
             if(!inputSignal_)throw std::runtime_error("Failed to get signal: " + input_signal_name_ + " Right Channel");
-            fft_ = kiss_fft_alloc(fft_size_, 0, nullptr, nullptr);
-            if (!fft_)
+            setupPlans();
+            for (ChannelType channel : { ChannelType::Mono, ChannelType::Left, ChannelType::Right })
             {
-                throw std::runtime_error("Failed to allocate memory for FFT.");
+                ChannelOutputs* outputs = getChannelOutputs(channel);
+                for (size_t r = 0; r < RESOLUTION_COUNT; ++r)
+                {
+                    outputs->magnitudes[r].reserve(maxPlanSize_ / RESOLUTION_DIVISORS[r] / 2 + 1);
+                }
             }
-            fftOutput_.resize(fft_size_);        
-            registerCallbacks();
-            fftThread_ = std::thread(&FFTComputer::processQueue, this);
-
+#ifdef FIXED_POINT
+            logger_->info("FFT Computer: Using {} bit fixed point FFT.", FIXED_POINT);
+#endif
             minDbSignalCallback_ = [](const float& value, void* arg)
             {
                 FFTComputer* self = static_cast<FFTComputer*>(arg);
                 self->minDbValue_ = value;
-                self->logger_->info("FFT Computer: Received new Min Db value: {}", value);
+                self->logger_->debug("FFT Computer: Received new Min Db value: {}", value);
             };
-            minDbSignal_ = std::dynamic_pointer_cast<Signal<float>>(SignalManager::getInstance().getSharedSignalByName("Min db"));
+            minDbSignal_ = SignalManager::getInstance().getSignal(SignalKeys::MinDb);
             if (minDbSignal_)
             {
                 minDbSignal_->setValue(minDbValue_);
@@ -94,10 +182,10 @@ class FFTComputer
             {
                 FFTComputer* self = static_cast<FFTComputer*>(arg);
                 self->maxDbValue_ = value;
-                self->logger_->info("FFT Computer: Received new Max Db value: {}", value);
+                self->logger_->debug("FFT Computer: Received new Max Db value: {}", value);
             };
 
-            maxDbSignal_ = std::dynamic_pointer_cast<Signal<float>>(SignalManager::getInstance().getSharedSignalByName("Max db"));
+            maxDbSignal_ = SignalManager::getInstance().getSignal(SignalKeys::MaxDb);
             if (maxDbSignal_)
             {
                 maxDbSignal_->setValue(maxDbValue_);
@@ -108,6 +196,222 @@ class FFTComputer
                 logger_->warn("FFT Computer: Max db signal not found, using default value: {}", maxDbValue_);
             }
 
+            overflowPolicySignalCallback_ = [](const std::string& value, void* arg)
+            {
+                FFTComputer* self = static_cast<FFTComputer*>(arg);
+                try
+                {
+                    self->overflowPolicy_ = from_string<FFTQueueOverflowPolicy>(value);
+                    self->logger_->info("FFT Computer: Received new Queue Overflow Policy: {}", value);
+                }
+                catch (const std::exception& e)
+                {
+                    self->logger_->error("FFT Computer: Invalid Queue Overflow Policy '{}': {}", value, e.what());
+                }
+            };
+
+            overflowPolicySignal_ = SignalManager::getInstance().getSignal(SignalKeys::FFTQueueOverflowPolicy);
+            if (overflowPolicySignal_)
+            {
+                overflowPolicySignal_->setValue(to_string(overflowPolicy_.load()));
+                overflowPolicySignal_->registerSignalValueCallback(overflowPolicySignalCallback_, this);
+            }
+            else
+            {
+                logger_->warn("FFT Computer: Queue Overflow Policy signal not found, using default value: {}", to_string(overflowPolicy_.load()));
+            }
+
+            fftSizeSignalCallback_ = [](const uint32_t& value, void* arg)
+            {
+                FFTComputer* self = static_cast<FFTComputer*>(arg);
+                if (self->plans_.count(value) == 0)
+                {
+                    // Written back so the UI and getValue report the size actually in use.
+                    self->logger_->error("FFT Computer: Unsupported FFT Size {}, keeping {}", value, self->requestedFFTSize_.load());
+                    self->postWriteBack(self->fftSizeSignal_, value, static_cast<uint32_t>(self->requestedFFTSize_.load()));
+                    return;
+                }
+                self->requestedFFTSize_ = value;
+                self->logger_->info("FFT Computer: Received new FFT Size: {}", value);
+            };
+
+            fftSizeSignal_ = SignalManager::getInstance().getSignal(SignalKeys::FFTSize);
+            if (fftSizeSignal_)
+            {
+                fftSizeSignal_->setValue(static_cast<uint32_t>(requestedFFTSize_.load()));
+                fftSizeSignal_->registerSignalValueCallback(fftSizeSignalCallback_, this);
+            }
+            else
+            {
+                logger_->warn("FFT Computer: FFT Size signal not found, using default value: {}", requestedFFTSize_.load());
+            }
+
+            fftHopSignalCallback_ = [](const uint32_t& value, void* arg)
+            {
+                FFTComputer* self = static_cast<FFTComputer*>(arg);
+                const size_t hop = std::clamp<size_t>(value, MINIMUM_HOP_SIZE, self->maxPlanSize_);
+                self->hopSize_ = hop;
+                self->logger_->info("FFT Computer: Received new FFT Hop: {}", hop);
+                if (hop != value)
+                {
+                    self->postWriteBack(self->fftHopSignal_, value, static_cast<uint32_t>(hop));
+                }
+            };
+
+            fftHopSignal_ = SignalManager::getInstance().getSignal(SignalKeys::FFTHop);
+            if (fftHopSignal_)
+            {
+                fftHopSignal_->setValue(static_cast<uint32_t>(hopSize_.load()));
+                fftHopSignal_->registerSignalValueCallback(fftHopSignalCallback_, this);
+            }
+            else
+            {
+                logger_->warn("FFT Computer: FFT Hop signal not found, using default value: {}", hopSize_.load());
+            }
+
+            spectrumColumnRateSignalCallback_ = [](const float& value, void* arg)
+            {
+                FFTComputer* self = static_cast<FFTComputer*>(arg);
+                self->spectrumColumnRate_ = std::max(0.0f, value);
+                self->logger_->info("FFT Computer: Received new Spectrum Column Rate: {}", value);
+            };
+
+            spectrumColumnRateSignal_ = SignalManager::getInstance().getSignal(SignalKeys::SpectrumColumnRate);
+            if (spectrumColumnRateSignal_)
+            {
+                spectrumColumnRateSignal_->setValue(spectrumColumnRate_.load());
+                spectrumColumnRateSignal_->registerSignalValueCallback(spectrumColumnRateSignalCallback_, this);
+            }
+            else
+            {
+                logger_->warn("FFT Computer: Spectrum Column Rate signal not found, using default value: {}", spectrumColumnRate_.load());
+            }
+
+            spectrumFormatSignalCallback_ = [](const std::string& value, void* arg)
+            {
+                FFTComputer* self = static_cast<FFTComputer*>(arg);
+                try
+                {
+                    self->spectrumFormat_ = from_string<SpectrumValueFormat>(value);
+                    self->logger_->info("FFT Computer: Received new Spectrum Format: {}", value);
+                }
+                catch (const std::exception& e)
+                {
+                    self->logger_->error("FFT Computer: Invalid Spectrum Format '{}': {}", value, e.what());
+                }
+            };
+
+            spectrumFormatSignal_ = SignalManager::getInstance().getSignal(SignalKeys::SpectrumFormat);
+            if (spectrumFormatSignal_)
+            {
+                spectrumFormatSignal_->setValue(to_string(spectrumFormat_.load()));
+                spectrumFormatSignal_->registerSignalValueCallback(spectrumFormatSignalCallback_, this);
+            }
+            else
+            {
+                logger_->warn("FFT Computer: Spectrum Format signal not found, using default value: {}", to_string(spectrumFormat_.load()));
+            }
+
+            analysisEngineSignalCallback_ = [](const std::string& value, void* arg)
+            {
+                FFTComputer* self = static_cast<FFTComputer*>(arg);
+                try
+                {
+                    self->analysisEngine_ = from_string<AnalysisEngine>(value);
+                    self->logger_->info("FFT Computer: Received new Analysis Engine: {}", value);
+                }
+                catch (const std::exception& e)
+                {
+                    self->logger_->error("FFT Computer: Invalid Analysis Engine '{}': {}", value, e.what());
+                }
+            };
+
+            analysisEngineSignal_ = SignalManager::getInstance().getSignal(SignalKeys::AnalysisEngine);
+            if (analysisEngineSignal_)
+            {
+                analysisEngineSignal_->registerSignalValueCallback(analysisEngineSignalCallback_, this);
+            }
+            else
+            {
+                logger_->warn("FFT Computer: Analysis Engine signal not found, using default value: {}", to_string(analysisEngine_.load()));
+            }
+
+            dbRangeModeSignalCallback_ = [](const std::string& value, void* arg)
+            {
+                FFTComputer* self = static_cast<FFTComputer*>(arg);
+                try
+                {
+                    const DbRangeMode mode = from_string<DbRangeMode>(value);
+                    if (mode == DbRangeMode::Auto && self->dbRangeMode_ != DbRangeMode::Auto)
+                    {
+                        self->resetDynamicRange_ = true;
+                    }
+                    self->dbRangeMode_ = mode;
+                    self->logger_->info("FFT Computer: Received new db Range Mode: {}", value);
+                }
+                catch (const std::exception& e)
+                {
+                    self->logger_->error("FFT Computer: Invalid db Range Mode '{}': {}", value, e.what());
+                }
+            };
+
+            dbRangeModeSignal_ = SignalManager::getInstance().getSignal(SignalKeys::DbRangeMode);
+            if (dbRangeModeSignal_)
+            {
+                dbRangeModeSignal_->setValue(to_string(dbRangeMode_.load()));
+                dbRangeModeSignal_->registerSignalValueCallback(dbRangeModeSignalCallback_, this);
+            }
+            else
+            {
+                logger_->warn("FFT Computer: db Range Mode signal not found, using default value: {}", to_string(dbRangeMode_.load()));
+            }
+
+            batchPublishModeSignalCallback_ = [](const std::string& value, void* arg)
+            {
+                FFTComputer* self = static_cast<FFTComputer*>(arg);
+                try
+                {
+                    self->batchPublishMode_ = from_string<FFTBatchPublishMode>(value);
+                    self->logger_->info("FFT Computer: Received new Batch Publish Mode: {}", value);
+                }
+                catch (const std::exception& e)
+                {
+                    self->logger_->error("FFT Computer: Invalid Batch Publish Mode '{}': {}", value, e.what());
+                }
+            };
+
+            batchPublishModeSignal_ = SignalManager::getInstance().getSignal(SignalKeys::FFTBatchPublishMode);
+            if (batchPublishModeSignal_)
+            {
+                batchPublishModeSignal_->setValue(to_string(batchPublishMode_.load()));
+                batchPublishModeSignal_->registerSignalValueCallback(batchPublishModeSignalCallback_, this);
+            }
+            else
+            {
+                logger_->warn("FFT Computer: Batch Publish Mode signal not found, using default value: {}", to_string(batchPublishMode_.load()));
+            }
+
+            harmonicPitchSignalCallback_ = [](const bool& value, void* arg)
+            {
+                FFTComputer* self = static_cast<FFTComputer*>(arg);
+                self->harmonicPitchEnabled_ = value;
+                self->logger_->info("FFT Computer: Harmonic Pitch Detection {}", value ? "enabled" : "disabled");
+            };
+
+            harmonicPitchSignal_ = SignalManager::getInstance().getSignal(SignalKeys::HarmonicPitchDetection);
+            if (harmonicPitchSignal_)
+            {
+                harmonicPitchSignal_->setValue(harmonicPitchEnabled_.load());
+                harmonicPitchSignal_->registerSignalValueCallback(harmonicPitchSignalCallback_, this);
+            }
+            else
+            {
+                logger_->warn("FFT Computer: Harmonic Pitch Detection signal not found, using default value: {}", harmonicPitchEnabled_.load());
+            }
+
+            // Last, the FFT thread reads the signal members set up above.
+            registerCallbacks();
+            fftThread_ = std::thread(&FFTComputer::processQueue, this);
         }
 
         ~FFTComputer()
@@ -120,9 +424,26 @@ class FFTComputer
             }
 
             unregisterCallbacks();
-            if (fft_)
+            if (minDbSignal_) minDbSignal_->unregisterSignalValueCallbackByArg(this);
+            if (maxDbSignal_) maxDbSignal_->unregisterSignalValueCallbackByArg(this);
+            if (overflowPolicySignal_) overflowPolicySignal_->unregisterSignalValueCallbackByArg(this);
+            if (fftSizeSignal_) fftSizeSignal_->unregisterSignalValueCallbackByArg(this);
+            if (fftHopSignal_) fftHopSignal_->unregisterSignalValueCallbackByArg(this);
+            if (spectrumColumnRateSignal_) spectrumColumnRateSignal_->unregisterSignalValueCallbackByArg(this);
+            if (spectrumFormatSignal_) spectrumFormatSignal_->unregisterSignalValueCallbackByArg(this);
+            if (harmonicPitchSignal_) harmonicPitchSignal_->unregisterSignalValueCallbackByArg(this);
+            if (batchPublishModeSignal_) batchPublishModeSignal_->unregisterSignalValueCallbackByArg(this);
+            if (dbRangeModeSignal_) dbRangeModeSignal_->unregisterSignalValueCallbackByArg(this);
+            if (analysisEngineSignal_) analysisEngineSignal_->unregisterSignalValueCallbackByArg(this);
+            for (auto& [size, plan] : plans_)
             {
-                free(fft_);
+                for (FFTResolution& resolution : plan->resolutions)
+                {
+                    if (resolution.cfg)
+                    {
+                        kiss_fftr_free(resolution.cfg);
+                    }
+                }
             }
         }
 
@@ -130,7 +451,11 @@ class FFTComputer
         {
             {
                 std::lock_guard<std::mutex> lock(queueMutex_);
-                dataQueue_.emplace(data, channel);
+                if (dataQueue_.size() >= maxQueueDepth_)
+                {
+                    handleQueueOverflow();
+                }
+                dataQueue_.emplace_back(data, channel, std::chrono::steady_clock::now());
             }
             cv_.notify_one();
         }
@@ -145,8 +470,10 @@ class FFTComputer
         {
             std::vector<int32_t> data;
             ChannelType channel;
+            std::chrono::steady_clock::time_point enqueuedAt;
             DataPacket() : data(), channel(ChannelType::Mono) {}
             DataPacket(std::vector<int32_t> d, ChannelType c) : data(std::move(d)), channel(c) {}
+            DataPacket(std::vector<int32_t> d, ChannelType c, std::chrono::steady_clock::time_point t) : data(std::move(d)), channel(c), enqueuedAt(t) {}
         };
 
         std::string name_;
@@ -156,27 +483,162 @@ class FFTComputer
         unsigned int sampleRate_;
         int32_t maxValue_;
         std::shared_ptr<WebSocketServer> webSocketServer_;
+        const size_t maxQueueDepth_;
+        std::atomic<FFTQueueOverflowPolicy> overflowPolicy_;
 
         std::atomic<bool> stopFlag_;
         std::thread fftThread_;
         std::mutex queueMutex_;
         std::condition_variable cv_;
-        std::queue<DataPacket> dataQueue_;
-        kiss_fft_cfg fft_;
-        std::vector<kiss_fft_cpx> fftOutput_;
+        std::deque<DataPacket> dataQueue_;
+        uint32_t droppedPackets_ = 0;
+        bool discontinuity_ = false;
+
+        // One real FFT per analysis resolution, all reading the newest samples of the same plan sized window.
+        // The magnitudes live in each channel's outputs, a resolution that is not due keeps the channel's last ones.
+        struct FFTResolution
+        {
+            size_t size = 0;
+            size_t updateInterval = 1;      // Hops between transforms, see buildPlan
+            kiss_fftr_cfg cfg = nullptr;
+            float magnitudeScale = 1.0f;
+            float bandPowerScale = 1.0f;
+            std::vector<kiss_fft_scalar> window;
+            std::vector<kiss_fft_scalar> input;
+            std::vector<kiss_fft_cpx> output;
+        };
+
+        // Triangular mel filter stored as its non zero weights starting at binStart.
+        struct MelFilter
+        {
+            size_t binStart = 0;
+            std::vector<float> weights;
+        };
+
+        struct BandBinRange
+        {
+            size_t resolution = 0;
+            size_t binStart = 0;
+            size_t binEnd = 0;
+        };
+
+        // Everything needed to analyse one FFT size, built up front so switching sizes never allocates.
+        // resolutions[0] is always the plan size itself and drives BinData.
+        struct FFTPlan
+        {
+            size_t size = 0;
+            std::vector<FFTResolution> resolutions;
+            std::array<BandBinRange, 32> bandBins;
+            std::vector<std::pair<size_t, size_t>> spectrumBins;
+            float spectrumMinFrequency = 0.0f;
+            float spectrumMaxFrequency = 0.0f;
+            std::vector<MelFilter> melFilters;
+        };
+
+        // Samples kept per channel, compacted in place so the FFT can read its window without copying.
+        struct ChannelHistory
+        {
+            std::vector<int32_t> samples;
+            size_t count = 0;
+            size_t unprocessed = 0;
+        };
+
+        static constexpr size_t SUPPORTED_FFT_SIZES[] = { 1024, 2048, 4096, 8192, 16384 };
+        static constexpr size_t RESOLUTION_DIVISORS[] = { 1, 4, 16 };
+        static constexpr size_t RESOLUTION_COUNT = std::size(RESOLUTION_DIVISORS);
+        static constexpr size_t MINIMUM_RESOLUTION_SIZE = 256;
+        static constexpr size_t DEFAULT_HOP_SIZE = 512;
+        static constexpr size_t MINIMUM_HOP_SIZE = 64;
+        static constexpr size_t SPECTRUM_BIN_COUNT = 128;
+        static constexpr float SPECTRUM_MIN_FREQUENCY = 20.0f;
+        static constexpr float SPECTRUM_MAX_FREQUENCY = 20000.0f;
+        static constexpr float DEFAULT_SPECTRUM_COLUMN_RATE = 60.0f;
+        static constexpr size_t MEL_BAND_COUNT = 40;
+        static constexpr size_t MFCC_COUNT = 13;
+        static constexpr float MEL_MIN_FREQUENCY = 20.0f;
+        static constexpr float MEL_MAX_FREQUENCY = 8000.0f;
+        static constexpr std::chrono::milliseconds DB_RANGE_PUBLISH_INTERVAL{1000};
+        static constexpr std::chrono::milliseconds QUEUE_METRICS_PUBLISH_INTERVAL{100};
+        static constexpr float DB_RANGE_RESOLUTION = 0.5f;
+        static constexpr size_t HPS_HARMONICS = 5;
+        static constexpr float HPS_MIN_FREQUENCY = 50.0f;
+        static constexpr float HPS_MAX_FREQUENCY = 2000.0f;
+
+        std::map<size_t, std::unique_ptr<FFTPlan>> plans_;
+        size_t maxPlanSize_ = 0;
+        std::vector<float> mfccDct_;
+        std::atomic<size_t> requestedFFTSize_;
+        std::atomic<size_t> hopSize_;
         std::function<void(const std::vector<float>&, ChannelType)> fftCallback_;
-        const float sqrt2 = std::sqrt(2.0);
         std::shared_ptr<spdlog::logger> logger_;
+        std::shared_ptr<RateLimitedLogger> rate_limited_log_;
 
         Signal<std::vector<int32_t>>* inputSignal_;
         Signal<std::vector<int32_t>>* inputSignalLeftChannel_;
         Signal<std::vector<int32_t>>* inputSignalRightChannel_;
-        std::shared_ptr<Signal<std::vector<float>>> monoOutputSignal_ = SignalManager::getInstance().createSignal<std::vector<float>>(output_signal_name_, webSocketServer_, get_fft_bands_encoder());
-        std::shared_ptr<Signal<std::vector<float>>> leftChannelOutputSignal_ = SignalManager::getInstance().createSignal<std::vector<float>>(output_signal_name_ + " Left Channel", webSocketServer_, get_fft_bands_encoder());
-        std::shared_ptr<Signal<std::vector<float>>> rightChannelOutputSignal_ = SignalManager::getInstance().createSignal<std::vector<float>>(output_signal_name_ + " Right Channel", webSocketServer_, get_fft_bands_encoder());
-        std::shared_ptr<Signal<BinData>> monoBinDataSignal_ = SignalManager::getInstance().createSignal<BinData>(output_signal_name_ + " Mono Bin Data", webSocketServer_, get_bin_data_encoder());
-        std::shared_ptr<Signal<BinData>> leftBinDataSignal_ = SignalManager::getInstance().createSignal<BinData>(output_signal_name_ + " Left Bin Data", webSocketServer_, get_bin_data_encoder());
-        std::shared_ptr<Signal<BinData>> rightBinDataSignal_ = SignalManager::getInstance().createSignal<BinData>(output_signal_name_ + " Right Bin Data", webSocketServer_, get_bin_data_encoder());
+
+        // Results of the newest frame (or the merge of a backlog's frames) waiting to be published.
+        struct ChannelFrame
+        {
+            std::vector<float> saeBands = std::vector<float>(ISO_32_BAND_CENTERS.size(), 0.0f);
+            BinData binData;
+            std::vector<float> melEnergies = std::vector<float>(MEL_BAND_COUNT, 0.0f);
+            std::vector<float> mfccs = std::vector<float>(MFCC_COUNT, 0.0f);
+            SpectrumColumn spectrumColumn;
+            bool spectrumColumnReady = false;
+            size_t frames = 0;
+        };
+
+        struct ChannelOutputs
+        {
+            ChannelFrame frame;
+            std::vector<float> scratchBands = std::vector<float>(ISO_32_BAND_CENTERS.size(), 0.0f);
+            // Newest magnitudes per resolution of the current plan, reserved for the largest plan in the constructor.
+            std::array<std::vector<float>, RESOLUTION_COUNT> magnitudes;
+            const FFTPlan* magnitudesPlan = nullptr;
+            size_t hopCount = 0;
+            std::shared_ptr<Signal<std::vector<float>>> bands;
+            std::shared_ptr<Signal<BinData>> binData;
+            std::shared_ptr<Signal<SpectrumColumn>> spectrum;
+            std::shared_ptr<Signal<std::vector<float>>> melEnergies;
+            std::shared_ptr<Signal<std::vector<float>>> mfccs;
+            std::chrono::steady_clock::time_point nextSpectrumColumn;
+            SignalBatch batch;      // Reused every frame, FFT thread only
+        };
+
+        ChannelOutputs createChannelOutputs(const std::string& bandsSignalName, const std::string& channelName)
+        {
+            ChannelOutputs outputs;
+            outputs.bands = SignalManager::getInstance().createSignal<std::vector<float>>(bandsSignalName, webSocketServer_, get_band_vector_encoder());
+            outputs.bands->setWebSocketLayout(get_fft_bands_layout());
+            outputs.binData = SignalManager::getInstance().createSignal<BinData>(output_signal_name_ + " " + channelName + " Bin Data", webSocketServer_, get_bin_data_encoder());
+            outputs.spectrum = SignalManager::getInstance().createSignal<SpectrumColumn>(output_signal_name_ + " " + channelName + " Spectrum", webSocketServer_, get_spectrum_column_encoder());
+            // A repeated column is still a new column of the spectrogram, so it always publishes.
+            outputs.spectrum->setChangeDetection(ChangeDetection::AlwaysPublish);
+            outputs.spectrum->enableHistory(WEBSOCKET_DISPLAY_HISTORY_ENTRIES);
+            outputs.melEnergies = SignalManager::getInstance().createSignal<std::vector<float>>(output_signal_name_ + " " + channelName + " Mel Energies", webSocketServer_, get_timestamped_float_vector_encoder());
+            outputs.mfccs = SignalManager::getInstance().createSignal<std::vector<float>>(output_signal_name_ + " " + channelName + " MFCC", webSocketServer_, get_timestamped_float_vector_encoder());
+            // Views only, the FFT publishes faster than a browser draws. Spectrum columns are a stream and are not conflated.
+            outputs.binData->setWebSocketMaxRate(WEBSOCKET_DISPLAY_RATE_HZ);
+            outputs.melEnergies->setWebSocketMaxRate(WEBSOCKET_DISPLAY_RATE_HZ);
+            outputs.mfccs->setWebSocketMaxRate(WEBSOCKET_DISPLAY_RATE_HZ);
+            return outputs;
+        }
+
+        ChannelOutputs monoOutputs_ = createChannelOutputs(output_signal_name_, "Mono");
+        ChannelOutputs leftOutputs_ = createChannelOutputs(output_signal_name_ + " Left Channel", "Left");
+        ChannelOutputs rightOutputs_ = createChannelOutputs(output_signal_name_ + " Right Channel", "Right");
+
+        ChannelOutputs* getChannelOutputs(ChannelType channel)
+        {
+            switch (channel)
+            {
+                case ChannelType::Mono: return &monoOutputs_;
+                case ChannelType::Left: return &leftOutputs_;
+                case ChannelType::Right: return &rightOutputs_;
+                default: return nullptr;
+            }
+        }
         
         std::shared_ptr<Signal<float>> minDbSignal_;
         float minDbValue_ = 0.0f;
@@ -185,6 +647,50 @@ class FFTComputer
         std::function<void(const float&, void*)> minDbSignalCallback_;
         std::function<void(const float&, void*)> maxDbSignalCallback_;
 
+        std::shared_ptr<Signal<std::string>> overflowPolicySignal_;
+        std::function<void(const std::string&, void*)> overflowPolicySignalCallback_;
+        std::shared_ptr<Signal<uint32_t>> queueDepthSignal_ = SignalManager::getInstance().createSignal<uint32_t>(name_ + " Queue Depth", webSocketServer_, get_signal_and_value_encoder<uint32_t>());
+        std::shared_ptr<Signal<uint32_t>> droppedPacketsSignal_ = SignalManager::getInstance().createSignal<uint32_t>(name_ + " Dropped Packets", webSocketServer_, get_signal_and_value_encoder<uint32_t>());
+        std::shared_ptr<Signal<float>> processingLagSignal_ = SignalManager::getInstance().createSignal<float>(name_ + " Processing Lag", webSocketServer_, get_signal_and_value_encoder<float>());
+        // Worst values since the last queue metrics publish, only touched by the processing thread.
+        std::chrono::steady_clock::time_point lastQueueMetricsPublish_;
+        size_t peakQueueDepth_ = 0;
+        float peakProcessingLagMs_ = 0.0f;
+
+        std::shared_ptr<Signal<uint32_t>> fftSizeSignal_;
+        std::function<void(const uint32_t&, void*)> fftSizeSignalCallback_;
+        std::shared_ptr<Signal<uint32_t>> fftHopSignal_;
+        std::function<void(const uint32_t&, void*)> fftHopSignalCallback_;
+
+        std::atomic<float> spectrumColumnRate_{DEFAULT_SPECTRUM_COLUMN_RATE};
+        std::shared_ptr<Signal<float>> spectrumColumnRateSignal_;
+        std::function<void(const float&, void*)> spectrumColumnRateSignalCallback_;
+        std::atomic<SpectrumValueFormat> spectrumFormat_{SpectrumValueFormat::UInt8};
+        std::shared_ptr<Signal<std::string>> spectrumFormatSignal_;
+        std::function<void(const std::string&, void*)> spectrumFormatSignalCallback_;
+
+        // Automatic Min db / Max db, fed with the unnormalized band levels of every frame.
+        std::atomic<DbRangeMode> dbRangeMode_{DbRangeMode::Manual};
+        std::atomic<bool> resetDynamicRange_{true};
+        std::shared_ptr<Signal<std::string>> dbRangeModeSignal_;
+        std::function<void(const std::string&, void*)> dbRangeModeSignalCallback_;
+        DynamicRangeTracker dynamicRange_;
+        std::array<float, 32> bandLevelsDb_ = {};
+        std::chrono::steady_clock::time_point lastRangeObservation_;
+        std::chrono::steady_clock::time_point lastRangePublish_;
+
+        std::atomic<AnalysisEngine> analysisEngine_{AnalysisEngine::FFT};
+        std::shared_ptr<Signal<std::string>> analysisEngineSignal_;
+        std::function<void(const std::string&, void*)> analysisEngineSignalCallback_;
+
+        std::atomic<FFTBatchPublishMode> batchPublishMode_{FFTBatchPublishMode::Latest};
+        std::shared_ptr<Signal<std::string>> batchPublishModeSignal_;
+        std::function<void(const std::string&, void*)> batchPublishModeSignalCallback_;
+
+        std::atomic<bool> harmonicPitchEnabled_{false};
+        std::shared_ptr<Signal<bool>> harmonicPitchSignal_;
+        std::function<void(const bool&, void*)> harmonicPitchSignalCallback_;
+
         void registerCallbacks()
         {
             auto callback = [](const std::vector<int32_t>& value, void* arg, ChannelType channel)
@@ -194,9 +700,11 @@ class FFTComputer
                 self->addData(value, channel);
             };
 
-            inputSignal_->registerSignalValueCallback( [callback](const std::vector<int32_t>& value, void* arg) { callback(value, arg, ChannelType::Mono); }, this );
-            inputSignalLeftChannel_->registerSignalValueCallback( [callback](const std::vector<int32_t>& value, void* arg) { callback(value, arg, ChannelType::Left); }, this );
-            inputSignalRightChannel_->registerSignalValueCallback( [callback](const std::vector<int32_t>& value, void* arg) { callback(value, arg, ChannelType::Right); }, this );
+            // Queued on one executor so the capture thread never waits on queueMutex_ and the channels keep their order.
+            const std::string executorName = name_ + " Input";
+            inputSignal_->registerSignalValueCallback( [callback](const std::vector<int32_t>& value, void* arg) { callback(value, arg, ChannelType::Mono); }, this, CallbackDispatch::Queued, executorName );
+            inputSignalLeftChannel_->registerSignalValueCallback( [callback](const std::vector<int32_t>& value, void* arg) { callback(value, arg, ChannelType::Left); }, this, CallbackDispatch::Queued, executorName );
+            inputSignalRightChannel_->registerSignalValueCallback( [callback](const std::vector<int32_t>& value, void* arg) { callback(value, arg, ChannelType::Right); }, this, CallbackDispatch::Queued, executorName );
         }
 
         void unregisterCallbacks()
@@ -206,97 +714,327 @@ class FFTComputer
             inputSignalRightChannel_->unregisterSignalValueCallbackByArg(this);
         }
 
+        // Replaces a rejected setting with the one in use. Posted, because setting the signal from inside its own
+        // callback would let later subscribers of the rejected value see it after the correction. Skipped when a
+        // newer value arrived meanwhile.
+        void postWriteBack(const std::shared_ptr<Signal<uint32_t>>& signal, uint32_t rejected, uint32_t inUse)
+        {
+            SignalExecutor::get(name_ + " Settings")->post([signal, rejected, inUse]()
+            {
+                if (signal->getValue() == rejected)
+                {
+                    signal->setValue(inUse);
+                }
+            });
+        }
+
+        // Called with queueMutex_ held when the queue is at capacity.
+        void handleQueueOverflow()
+        {
+            switch (overflowPolicy_.load())
+            {
+                case FFTQueueOverflowPolicy::SkipToLatest:
+                    // Everything queued is stale, restart every channel from the newest packet.
+                    droppedPackets_ += static_cast<uint32_t>(dataQueue_.size());
+                    dataQueue_.clear();
+                    discontinuity_ = true;
+                break;
+                case FFTQueueOverflowPolicy::BatchCatchUp:
+                    // Give a burst time to be drained in one batch, the queue may grow to twice the depth before dropping.
+                    if (dataQueue_.size() < 2 * maxQueueDepth_) return;
+                    dataQueue_.pop_front();
+                    ++droppedPackets_;
+                break;
+                case FFTQueueOverflowPolicy::DropOldest:
+                default:
+                    dataQueue_.pop_front();
+                    ++droppedPackets_;
+                break;
+            }
+            rate_limited_log_->log("overflow", spdlog::level::warn, "Device {}: FFT queue overflow, {} packets dropped so far.", name_, droppedPackets_);
+        }
+
+        // Called for every processed batch, publishes the worst depth and lag seen at most every QUEUE_METRICS_PUBLISH_INTERVAL.
+        void publishQueueMetrics(size_t queueDepth, uint32_t droppedPackets, std::chrono::steady_clock::time_point enqueuedAt)
+        {
+            const auto now = std::chrono::steady_clock::now();
+            peakQueueDepth_ = std::max(peakQueueDepth_, queueDepth);
+            peakProcessingLagMs_ = std::max(peakProcessingLagMs_, std::chrono::duration<float, std::milli>(now - enqueuedAt).count());
+            if (now - lastQueueMetricsPublish_ < QUEUE_METRICS_PUBLISH_INTERVAL) return;
+            lastQueueMetricsPublish_ = now;
+
+            queueDepthSignal_->setValue(static_cast<uint32_t>(peakQueueDepth_));
+            droppedPacketsSignal_->setValue(droppedPackets);
+            processingLagSignal_->setValue(peakProcessingLagMs_);
+            peakQueueDepth_ = 0;
+            peakProcessingLagMs_ = 0.0f;
+        }
+
         void processQueue()
         {
-            std::vector<int32_t> monoBuffer;
-            std::vector<int32_t> leftBuffer;
-            std::vector<int32_t> rightBuffer;
-            const size_t minimumStepSize = 512;
-            const size_t requiredSamples = fft_size_;
-            const size_t overlapSamples = std::min(fft_size_ - 512, std::max(minimumStepSize, fft_size_));
-            const size_t nonOverlappingSamples = requiredSamples - overlapSamples;
+            ChannelHistory monoHistory;
+            ChannelHistory leftHistory;
+            ChannelHistory rightHistory;
+            for (ChannelHistory* history : { &monoHistory, &leftHistory, &rightHistory })
+            {
+                history->samples.resize(4 * maxPlanSize_);
+            }
+            FFTPlan* plan = plans_.at(requestedFFTSize_.load()).get();
+            std::deque<DataPacket> pending;
 
             while (!stopFlag_)
             {
-                DataPacket dataPacket;
+                size_t queueDepth = 0;
+                uint32_t droppedPackets = 0;
+                bool batchCatchUp = false;
                 {
                     std::unique_lock<std::mutex> lock(queueMutex_);
                     cv_.wait(lock, [this] { return !dataQueue_.empty() || stopFlag_; });
                     if (stopFlag_) break;
-                    dataPacket = std::move(dataQueue_.front());
-                    dataQueue_.pop();
+                    if (discontinuity_)
+                    {
+                        monoHistory.count = monoHistory.unprocessed = 0;
+                        leftHistory.count = leftHistory.unprocessed = 0;
+                        rightHistory.count = rightHistory.unprocessed = 0;
+                        discontinuity_ = false;
+                    }
+                    // Batch Catch Up drains everything queued and merges each channel's frames into one publish.
+                    // The other policies take one packet at a time and publish every frame, so the queue and its
+                    // overflow policy see the whole backlog.
+                    batchCatchUp = overflowPolicy_ == FFTQueueOverflowPolicy::BatchCatchUp;
+                    if (batchCatchUp)
+                    {
+                        pending.swap(dataQueue_);
+                    }
+                    else
+                    {
+                        pending.push_back(std::move(dataQueue_.front()));
+                        dataQueue_.pop_front();
+                    }
+                    queueDepth = dataQueue_.size() + pending.size() - 1;
+                    droppedPackets = droppedPackets_;
+                }
+
+                // Size changes take effect on the next frame, the history already holds enough samples for any plan.
+                if (plan->size != requestedFFTSize_)
+                {
+                    plan = plans_.at(requestedFFTSize_.load()).get();
+                    logger_->info("Device {}: Switched to {} point FFT plan", name_, plan->size);
                 }
+                const size_t hop = std::min(hopSize_.load(), plan->size);
 
-                // Select buffer based on channel
-                std::vector<int32_t>* buffer = nullptr;
-                switch (dataPacket.channel)
+                // Under Batch Catch Up a channel with more than one packet drained is behind, it publishes once at the
+                // end of the batch instead of every frame, so signal callbacks and websocket encoding do not add to
+                // the backlog. Counted per channel, stereo capture always queues a Left and a Right packet back to back.
+                std::array<size_t, 3> channelPackets = {};
+                for (const DataPacket& dataPacket : pending)
                 {
-                    case ChannelType::Mono: buffer = &monoBuffer; break;
-                    case ChannelType::Left: buffer = &leftBuffer; break;
-                    case ChannelType::Right: buffer = &rightBuffer; break;
-                    default: continue;
+                    ++channelPackets[static_cast<size_t>(dataPacket.channel)];
                 }
+                const auto oldestEnqueuedAt = pending.front().enqueuedAt;
+                for (DataPacket& dataPacket : pending)
+                {
+                    // Select history based on channel
+                    ChannelHistory* history = nullptr;
+                    switch (dataPacket.channel)
+                    {
+                        case ChannelType::Mono: history = &monoHistory; break;
+                        case ChannelType::Left: history = &leftHistory; break;
+                        case ChannelType::Right: history = &rightHistory; break;
+                        default: continue;
+                    }
 
-                buffer->insert(buffer->end(), std::make_move_iterator(dataPacket.data.begin()), std::make_move_iterator(dataPacket.data.end()));
+                    appendSamples(*history, dataPacket.data);
 
-                while (buffer->size() >= requiredSamples)
+                    const bool backlogged = batchCatchUp && channelPackets[static_cast<size_t>(dataPacket.channel)] > 1;
+                    while (history->unprocessed >= hop)
+                    {
+                        history->unprocessed -= hop;
+                        const size_t frameEnd = history->count - history->unprocessed;
+                        if (frameEnd < plan->size) continue;
+                        processFFT(*plan, &history->samples[frameEnd - plan->size], dataPacket.channel, !backlogged);
+                    }
+                }
+                pending.clear();
+                for (ChannelType channel : { ChannelType::Mono, ChannelType::Left, ChannelType::Right })
                 {
-                    std::vector<int32_t> fftData(buffer->begin(), buffer->begin() + requiredSamples);
-                    buffer->erase(buffer->begin(), buffer->begin() + nonOverlappingSamples);
-                    processFFT({ std::move(fftData), dataPacket.channel });
+                    if (batchCatchUp && channelPackets[static_cast<size_t>(channel)] > 1)
+                    {
+                        publishFrame(channel);
+                    }
                 }
+                publishQueueMetrics(queueDepth, droppedPackets, oldestEnqueuedAt);
             }
         }
 
+        // Never allocates, the history is sized for the largest plan when the worker starts.
+        void appendSamples(ChannelHistory& history, const std::vector<int32_t>& data)
+        {
+            // Compaction keeps at most 2 * maxPlanSize_, the rest of the history is room for a packet.
+            const size_t room = history.samples.size() - 2 * maxPlanSize_;
+            auto first = data.begin();
+            if (data.size() > room)
+            {
+                // Only possible for packets far larger than any plan. Its newest samples restart the history.
+                rate_limited_log_->log("oversized packet", spdlog::level::warn, "Device {}: {} sample packet exceeds the {} sample history room, analysing its newest samples only.", name_, data.size(), room);
+                first = data.end() - room;
+                history.count = history.unprocessed = 0;
+            }
+            const size_t size = static_cast<size_t>(data.end() - first);
+            if (history.count + size > history.samples.size())
+            {
+                // Keep enough to cover the largest plan plus a partially consumed hop.
+                const size_t keep = std::min(history.count, 2 * maxPlanSize_);
+                std::copy(history.samples.begin() + (history.count - keep), history.samples.begin() + history.count, history.samples.begin());
+                history.count = keep;
+            }
+            std::copy(first, data.end(), history.samples.begin() + history.count);
+            history.count += size;
+            history.unprocessed += size;
+        }
 
-        void processFFT(const DataPacket& dataPacket)
+        void processFFT(FFTPlan& plan, const int32_t* window, ChannelType channel, bool publish)
         {
-            std::vector<kiss_fft_cpx> inputData(fft_size_);
-            for (size_t i = 0; i < std::min(fft_size_, dataPacket.data.size()); ++i)
+            ChannelOutputs* outputs = getChannelOutputs(channel);
+            if (!outputs)
             {
-                inputData[i].r = static_cast<float>(dataPacket.data[i]);
-                inputData[i].i = 0;
+                logger_->error("Device {}: Unsupported channel type:", name_);
+                return;
             }
 
-            kiss_fft(fft_, inputData.data(), fftOutput_.data());
+            // Resolutions run on their own schedule, a new plan starts with all of them.
+            if (outputs->magnitudesPlan != &plan)
+            {
+                outputs->magnitudesPlan = &plan;
+                outputs->hopCount = 0;
+            }
+            for (size_t r = 0; r < plan.resolutions.size(); ++r)
+            {
+                FFTResolution& resolution = plan.resolutions[r];
+                if (outputs->hopCount % resolution.updateInterval == 0)
+                {
+                    computeMagnitudes(window, plan.size, resolution, outputs->magnitudes[r]);
+                }
+            }
+            ++outputs->hopCount;
 
-            std::vector<float> magnitudes(fft_size_, 0.0f);
-            std::vector<float> saeBands(32, 0.0f);
-            const float max_int32 = std::numeric_limits<int32_t>::max();
-            for (size_t i = 0; i < fft_size_; ++i)
+            ChannelFrame& frame = outputs->frame;
+            computeSAEBands(plan, outputs->magnitudes, outputs->scratchBands, frame.binData);
+            logSAEBands(outputs->scratchBands);
+            updateDynamicRange();
+            if (frame.frames == 0 || batchPublishMode_ == FFTBatchPublishMode::Latest)
             {
-                magnitudes[i] = sqrt(fftOutput_[i].r * fftOutput_[i].r + fftOutput_[i].i * fftOutput_[i].i);
-                magnitudes[i] /= maxValue_;
+                frame.saeBands = outputs->scratchBands;
             }
-            BinData binData;
-            computeSAEBands(magnitudes, saeBands, binData);
-            logSAEBands(saeBands);
+            else
+            {
+                for (size_t i = 0; i < frame.saeBands.size(); ++i)
+                {
+                    frame.saeBands[i] = std::max(frame.saeBands[i], outputs->scratchBands[i]);
+                }
+            }
+            computeMelFeatures(plan, outputs->magnitudes.front(), frame.melEnergies, frame.mfccs);
+            updateSpectrumColumn(plan, *outputs);
+            ++frame.frames;
+
+            if (publish)
+            {
+                publishFrame(channel);
+            }
+        }
+
+        void publishFrame(ChannelType channel)
+        {
+            ChannelOutputs* outputs = getChannelOutputs(channel);
+            if (!outputs || outputs->frame.frames == 0) return;
 
+            ChannelFrame& frame = outputs->frame;
+            if (frame.frames > 1)
+            {
+                logger_->debug("Device {}: Publishing {} channel after {} batched frames", name_, channelTypeToString(channel), frame.frames);
+            }
+            // The callback always gets the FFT's own bands. The IIR filterbank owns the band signals when selected,
+            // everything else is still published from here.
             if (fftCallback_)
             {
-                fftCallback_(saeBands, dataPacket.channel);
+                fftCallback_(frame.saeBands, channel);
             }
-            switch(dataPacket.channel)
+            if (analysisEngine_ == AnalysisEngine::FFT)
             {
-                case ChannelType::Mono:
-                    logger_->debug("Device {}: Set Mono Output Signal Value:", name_);
-                    monoOutputSignal_->setValue(saeBands);
-                    monoBinDataSignal_->setValue(binData);
-                break;
-                case ChannelType::Left:
-                    logger_->debug("Device {}: Set Left Output Signal Value:", name_);
-                    leftChannelOutputSignal_->setValue(saeBands);
-                    leftBinDataSignal_->setValue(binData);
-                break;
-                case ChannelType::Right:
-                    logger_->debug("Device {}: Set Right Output Signal Value:", name_);
-                    rightChannelOutputSignal_->setValue(saeBands);
-                    rightBinDataSignal_->setValue(binData);
-                break;
-                default:
-                    logger_->error("Device {}: Unsupported channel type:", name_);
-                break;
+                logger_->debug("Device {}: Set {} Output Signal Value:", name_, channelTypeToString(channel));
+                outputs->batch.set(outputs->bands, frame.saeBands);
+            }
+            // One commit per frame, subscribers never see the bands of one frame with the bin data of another.
+            // Each value is copied once, into its published snapshot. The frame keeps its buffers for the next frame.
+            outputs->batch.set(outputs->binData, frame.binData);
+            outputs->batch.set(outputs->melEnergies, frame.melEnergies);
+            outputs->batch.set(outputs->mfccs, frame.mfccs);
+            if (frame.spectrumColumnReady)
+            {
+                outputs->batch.set(outputs->spectrum, frame.spectrumColumn);
+                frame.spectrumColumnReady = false;
+            }
+            SignalManager::getInstance().commit(outputs->batch);
+            frame.frames = 0;
+        }
+
+        void updateSpectrumColumn(const FFTPlan& plan, ChannelOutputs& outputs)
+        {
+            const float columnRate = spectrumColumnRate_.load();
+            if (columnRate <= 0.0f) return;
+
+            // Columns are scheduled on a fixed grid so the average rate holds even though FFT frames arrive in bursts.
+            const auto now = std::chrono::steady_clock::now();
+            if (now < outputs.nextSpectrumColumn) return;
+            const auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(1.0f / columnRate));
+            outputs.nextSpectrumColumn = std::max(outputs.nextSpectrumColumn + interval, now);
+
+            const std::vector<float>& magnitudes = outputs.magnitudes.front();
+            SpectrumColumn& column = outputs.frame.spectrumColumn;
+            column.minFrequency = plan.spectrumMinFrequency;
+            column.maxFrequency = plan.spectrumMaxFrequency;
+            column.format = spectrumFormat_.load();
+            column.values.resize(plan.spectrumBins.size());
+            for (size_t i = 0; i < plan.spectrumBins.size(); ++i)
+            {
+                const auto& [binStart, binEnd] = plan.spectrumBins[i];
+                float peak = 0.0f;
+                for (size_t j = binStart; j <= binEnd; ++j)
+                {
+                    peak = std::max(peak, magnitudes[j]);
+                }
+                column.values[i] = normalizeDb(peak);
+            }
+            outputs.frame.spectrumColumnReady = true;
+        }
+
+        void updateDynamicRange()
+        {
+            if (dbRangeMode_ != DbRangeMode::Auto) return;
+
+            const auto now = std::chrono::steady_clock::now();
+            if (resetDynamicRange_.exchange(false))
+            {
+                dynamicRange_.reset(minDbValue_, maxDbValue_);
+                lastRangeObservation_ = now;
+                lastRangePublish_ = now;
             }
+            // Stereo frames arrive back to back, timing by the clock keeps the adaptation rate independent of the channel count.
+            const float elapsedSeconds = std::min(std::chrono::duration<float>(now - lastRangeObservation_).count(), 1.0f);
+            lastRangeObservation_ = now;
+            dynamicRange_.observe(bandLevelsDb_.data(), bandLevelsDb_.size(), elapsedSeconds);
+
+            if (now - lastRangePublish_ < DB_RANGE_PUBLISH_INTERVAL) return;
+            lastRangePublish_ = now;
+
+            // Quantized so the signals, and the websocket, only see meaningful changes.
+            const float minDb = std::round(dynamicRange_.minDb() / DB_RANGE_RESOLUTION) * DB_RANGE_RESOLUTION;
+            const float maxDb = std::round(dynamicRange_.maxDb() / DB_RANGE_RESOLUTION) * DB_RANGE_RESOLUTION;
+            if (minDbSignal_) minDbSignal_->setValue(minDb);
+            else minDbValue_ = minDb;
+            if (maxDbSignal_) maxDbSignal_->setValue(maxDb);
+            else maxDbValue_ = maxDb;
+            logger_->debug("Device {}: Auto db range {:.1f} to {:.1f}", name_, minDb, maxDb);
         }
 
         void logSAEBands(std::vector<float>& saeBands) const
@@ -310,16 +1048,266 @@ class FFTComputer
             logger_->trace("SAE Band Values: {}", result);
         }
 
+        static float amplitudeToDb(float amplitude)
+        {
+            return 20.0f * std::log10(amplitude + 1e-6f);
+        }
+
         float normalizeDb(float amplitude)
         {
-            float db = 20.0f * std::log10(amplitude + 1e-6f);
+            float db = amplitudeToDb(amplitude);
             float normalized = (db - minDbValue_) / (maxDbValue_ - minDbValue_);
             return std::clamp(normalized, 0.0f, 1.0f);
         }
 
-        void computeSAEBands(const std::vector<float>& magnitudes, std::vector<float>& saeBands, BinData& binData)
+        void setupPlans()
         {
-            float freqResolution = static_cast<float>(sampleRate_) / fft_size_;
+            // Orthonormal DCT-II rows, shared by every plan.
+            mfccDct_.resize(MFCC_COUNT * MEL_BAND_COUNT);
+            for (size_t k = 0; k < MFCC_COUNT; ++k)
+            {
+                const double scale = std::sqrt((k == 0 ? 1.0 : 2.0) / MEL_BAND_COUNT);
+                for (size_t n = 0; n < MEL_BAND_COUNT; ++n)
+                {
+                    mfccDct_[k * MEL_BAND_COUNT + n] = static_cast<float>(scale * std::cos(M_PI * k * (n + 0.5) / MEL_BAND_COUNT));
+                }
+            }
+
+            std::vector<size_t> sizes(std::begin(SUPPORTED_FFT_SIZES), std::end(SUPPORTED_FFT_SIZES));
+            if (std::find(sizes.begin(), sizes.end(), fft_size_) == sizes.end())
+            {
+                sizes.push_back(fft_size_);
+            }
+            for (size_t size : sizes)
+            {
+                plans_[size] = buildPlan(size);
+                maxPlanSize_ = std::max(maxPlanSize_, size);
+            }
+        }
+
+        std::unique_ptr<FFTPlan> buildPlan(size_t planSize)
+        {
+            auto plan = std::make_unique<FFTPlan>();
+            plan->size = planSize;
+
+            for (size_t divisor : RESOLUTION_DIVISORS)
+            {
+                const size_t size = planSize / divisor;
+                if (divisor > 1 && size < MINIMUM_RESOLUTION_SIZE) break;
+
+                FFTResolution resolution;
+                resolution.size = size;
+                resolution.cfg = kiss_fftr_alloc(static_cast<int>(size), 0, nullptr, nullptr);
+                if (!resolution.cfg)
+                {
+                    throw std::runtime_error("Failed to allocate memory for FFT.");
+                }
+
+                // Periodic Hann window, its 0.5 coherent gain is compensated in magnitudeScale.
+                const float coherentGain = 0.5f;
+                double windowPower = 0.0;
+                resolution.window.resize(size);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    const double w = 0.5 * (1.0 - std::cos(2.0 * M_PI * i / size));
+                    windowPower += w * w;
+#ifdef FIXED_POINT
+                    resolution.window[i] = static_cast<kiss_fft_scalar>(w * std::numeric_limits<int32_t>::max());
+#else
+                    resolution.window[i] = static_cast<kiss_fft_scalar>(w);
+#endif
+                }
+
+                // The fixed point kissfft build (FIXED_POINT=32, see FFT_FIXED_POINT in CMakeLists.txt) divides
+                // every butterfly stage to avoid overflow, so its output is the DFT scaled by 1/size.
+                // Rescaling restores the float path's levels. Rounding in each stage bounds the magnitude error
+                // to about log2(size) * planSize / maxValue_ (~0.013 for 8192 points of S24 audio),
+                // i.e. under 0.11 dB for any band at or above 0 dB, the default Min db floor. The fft_accuracy_check
+                // benchmark target measures it against the float build on a sine and on noise.
+#ifdef FIXED_POINT
+                const float outputScale = static_cast<float>(size);
+#else
+                const float outputScale = 1.0f;
+#endif
+                // Bring every resolution to the level of a planSize point transform so bands stay comparable.
+                resolution.magnitudeScale = outputScale * (static_cast<float>(planSize) / size) / (coherentGain * static_cast<float>(maxValue_));
+                // That scaling holds a pure tone level, but a bin's noise energy grows with the transform size, so
+                // bands sum energy instead. With the magnitudes above, size / (4 * window power) times the summed
+                // squares is the squared peak amplitude of a sine with the band's power, at the planSize level
+                // (Parseval). Tones and broadband content then read the same from every resolution.
+                resolution.bandPowerScale = static_cast<float>(size / (4.0 * windowPower));
+                resolution.input.resize(size);
+                resolution.output.resize(size / 2 + 1);
+                plan->resolutions.push_back(std::move(resolution));
+            }
+
+            // The short transforms run every hop, the full size one only every updateInterval hops, so the amortized
+            // cost stays below one full size transform per hop. In between its magnitudes are reused, the bass bands
+            // it feeds barely move within a few hops, the spectrum and mel features just repeat a column.
+            const auto fftCost = [](size_t size) { return 0.5f * size * std::log2(static_cast<float>(size)); };
+            const float fullCost = fftCost(planSize);
+            float shortCost = 0.0f;
+            for (size_t r = 1; r < plan->resolutions.size(); ++r)
+            {
+                shortCost += fftCost(plan->resolutions[r].size);
+            }
+            if (plan->resolutions.size() > 1)
+            {
+                if (shortCost >= fullCost)
+                {
+                    throw std::runtime_error("FFT Computer: short resolutions of the " + std::to_string(planSize) + " point plan exceed the per hop budget.");
+                }
+                plan->resolutions.front().updateInterval = static_cast<size_t>(std::floor(fullCost / (fullCost - shortCost))) + 1;
+            }
+
+            // Each band uses the shortest transform whose bin spacing is at most half the band's width,
+            // long windows for the bass and short, low latency windows for the treble.
+            for (size_t i = 0; i < ISO_32_BAND_CENTERS.size(); ++i)
+            {
+                const auto [lowerFreq, upperFreq] = isoBandEdges(i);
+
+                size_t selected = 0;
+                for (size_t r = plan->resolutions.size(); r-- > 0;)
+                {
+                    const float freqResolution = static_cast<float>(sampleRate_) / plan->resolutions[r].size;
+                    if (2.0f * freqResolution <= upperFreq - lowerFreq)
+                    {
+                        selected = r;
+                        break;
+                    }
+                }
+
+                const float freqResolution = static_cast<float>(sampleRate_) / plan->resolutions[selected].size;
+                const size_t lastBin = plan->resolutions[selected].size / 2;
+                plan->bandBins[i].resolution = selected;
+                plan->bandBins[i].binStart = std::min(static_cast<size_t>(std::floor(lowerFreq / freqResolution)), lastBin);
+                plan->bandBins[i].binEnd = std::min(static_cast<size_t>(std::ceil(upperFreq / freqResolution)), lastBin);
+                logger_->debug("Device {}: {} point plan, band {} Hz uses {} point FFT bins {}-{}", name_, planSize, ISO_32_BAND_CENTERS[i], plan->resolutions[selected].size, plan->bandBins[i].binStart, plan->bandBins[i].binEnd);
+            }
+
+            // Log spaced spectrum columns read from the full size transform.
+            const float binResolution = static_cast<float>(sampleRate_) / planSize;
+            const size_t lastBin = planSize / 2;
+            plan->spectrumMinFrequency = SPECTRUM_MIN_FREQUENCY;
+            plan->spectrumMaxFrequency = std::min(SPECTRUM_MAX_FREQUENCY, sampleRate_ / 2.0f);
+            const float spectrumRatio = plan->spectrumMaxFrequency / plan->spectrumMinFrequency;
+            plan->spectrumBins.resize(SPECTRUM_BIN_COUNT);
+            for (size_t i = 0; i < SPECTRUM_BIN_COUNT; ++i)
+            {
+                const float lowerFreq = plan->spectrumMinFrequency * std::pow(spectrumRatio, static_cast<float>(i) / SPECTRUM_BIN_COUNT);
+                const float upperFreq = plan->spectrumMinFrequency * std::pow(spectrumRatio, static_cast<float>(i + 1) / SPECTRUM_BIN_COUNT);
+                const size_t binStart = std::min(static_cast<size_t>(std::round(lowerFreq / binResolution)), lastBin);
+                const size_t binEnd = std::min(std::max(binStart, static_cast<size_t>(std::round(upperFreq / binResolution))), lastBin);
+                plan->spectrumBins[i] = { binStart, binEnd };
+            }
+
+            buildMelFilters(*plan);
+
+            const float amortizedCost = fullCost / plan->resolutions.front().updateInterval + shortCost;
+            if (amortizedCost > fullCost)
+            {
+                throw std::runtime_error("FFT Computer: the " + std::to_string(planSize) + " point plan exceeds one full size FFT per hop.");
+            }
+            logger_->info("Device {}: {} point plan costs {:.0f}% of a single real FFT of that size per hop, full size transform every {} hops", name_, planSize, 100.0f * amortizedCost / fullCost, plan->resolutions.front().updateInterval);
+            return plan;
+        }
+
+        static float hzToMel(float hz) { return 2595.0f * std::log10(1.0f + hz / 700.0f); }
+        static float melToHz(float mel) { return 700.0f * (std::pow(10.0f, mel / 2595.0f) - 1.0f); }
+
+        // HTK style triangles evenly spaced in mel over the full size transform, only the non zero weights are kept.
+        void buildMelFilters(FFTPlan& plan)
+        {
+            const float binResolution = static_cast<float>(sampleRate_) / plan.size;
+            const size_t lastBin = plan.size / 2;
+            const float minMel = hzToMel(MEL_MIN_FREQUENCY);
+            const float maxMel = hzToMel(std::min(MEL_MAX_FREQUENCY, sampleRate_ / 2.0f));
+
+            std::vector<float> edgeBins(MEL_BAND_COUNT + 2);
+            for (size_t i = 0; i < edgeBins.size(); ++i)
+            {
+                edgeBins[i] = melToHz(minMel + (maxMel - minMel) * i / (MEL_BAND_COUNT + 1)) / binResolution;
+            }
+
+            plan.melFilters.resize(MEL_BAND_COUNT);
+            for (size_t m = 0; m < MEL_BAND_COUNT; ++m)
+            {
+                const float left = edgeBins[m];
+                const float center = edgeBins[m + 1];
+                const float right = edgeBins[m + 2];
+                MelFilter& filter = plan.melFilters[m];
+                filter.binStart = std::min(static_cast<size_t>(std::ceil(left)), lastBin);
+                const size_t binEnd = std::min(static_cast<size_t>(std::floor(right)), lastBin);
+                for (size_t bin = filter.binStart; bin <= binEnd; ++bin)
+                {
+                    const float weight = bin <= center ? (bin - left) / (center - left) : (right - bin) / (right - center);
+                    filter.weights.push_back(std::max(0.0f, weight));
+                }
+                // Low bands of short plans can fall between bins, fall back to the nearest one.
+                if (filter.weights.empty() || *std::max_element(filter.weights.begin(), filter.weights.end()) == 0.0f)
+                {
+                    filter.binStart = std::min(static_cast<size_t>(std::round(center)), lastBin);
+                    filter.weights.assign(1, 1.0f);
+                }
+            }
+        }
+
+        // Log mel energies in dB (same reference as the band levels) and their MFCCs.
+        void computeMelFeatures(const FFTPlan& plan, const std::vector<float>& magnitudes, std::vector<float>& melEnergies, std::vector<float>& mfccs) const
+        {
+            for (size_t m = 0; m < MEL_BAND_COUNT; ++m)
+            {
+                const MelFilter& filter = plan.melFilters[m];
+                float energy = 0.0f;
+                for (size_t i = 0; i < filter.weights.size(); ++i)
+                {
+                    const float magnitude = magnitudes[filter.binStart + i];
+                    energy += filter.weights[i] * magnitude * magnitude;
+                }
+                melEnergies[m] = 10.0f * std::log10(energy + 1e-12f);
+            }
+
+            for (size_t k = 0; k < MFCC_COUNT; ++k)
+            {
+                const float* row = &mfccDct_[k * MEL_BAND_COUNT];
+                float sum = 0.0f;
+                for (size_t m = 0; m < MEL_BAND_COUNT; ++m)
+                {
+                    sum += row[m] * melEnergies[m];
+                }
+                mfccs[k] = sum;
+            }
+        }
+
+        void computeMagnitudes(const int32_t* window, size_t windowSize, FFTResolution& resolution, std::vector<float>& magnitudes)
+        {
+            // Short transforms analyse the most recent samples of the shared window.
+            const int32_t* samples = window + (windowSize - resolution.size);
+            for (size_t i = 0; i < resolution.size; ++i)
+            {
+#ifdef FIXED_POINT
+                // S24 samples fit the 32 bit fixed point scalar as they are, the Q31 window is applied in 64 bits.
+                resolution.input[i] = static_cast<kiss_fft_scalar>((static_cast<int64_t>(samples[i]) * resolution.window[i]) >> 31);
+#else
+                resolution.input[i] = static_cast<float>(samples[i]) * resolution.window[i];
+#endif
+            }
+
+            kiss_fftr(resolution.cfg, resolution.input.data(), resolution.output.data());
+
+            // Within the reserved capacity, never allocates.
+            magnitudes.resize(resolution.output.size());
+            for (size_t i = 0; i < resolution.output.size(); ++i)
+            {
+                const float r = static_cast<float>(resolution.output[i].r);
+                const float im = static_cast<float>(resolution.output[i].i);
+                magnitudes[i] = std::sqrt(r * r + im * im) * resolution.magnitudeScale;
+            }
+        }
+
+        void computeSAEBands(const FFTPlan& plan, const std::array<std::vector<float>, RESOLUTION_COUNT>& resolutionMagnitudes, std::vector<float>& saeBands, BinData& binData)
+        {
+            const std::vector<float>& magnitudes = resolutionMagnitudes.front();
 
             // Initialize min/max amplitude and bin indices
             binData.normalizedMinValue = std::numeric_limits<float>::max();
@@ -342,6 +1330,11 @@ class FFTComputer
                 }
             }
 
+            const float binResolution = static_cast<float>(sampleRate_) / plan.size;
+            binData.peakBin = interpolatePeak(magnitudes, binData.maxBin);
+            binData.peakFrequency = binData.peakBin * binResolution;
+            binData.pitchFrequency = harmonicPitchEnabled_ ? harmonicProductPitch(magnitudes, binResolution) : 0.0f;
+
             // Normalize to 0–1.0
             binData.normalizedMinValue = normalizeDb(binData.normalizedMinValue);
             binData.normalizedMaxValue = normalizeDb(binData.normalizedMaxValue);
@@ -349,64 +1342,61 @@ class FFTComputer
             // Compute SAE bands
             for (size_t i = 0; i < ISO_32_BAND_CENTERS.size(); ++i)
             {
-                float lowerFreq, upperFreq;
+                const BandBinRange& range = plan.bandBins[i];
+                const std::vector<float>& bandMagnitudes = resolutionMagnitudes[range.resolution];
 
-                if (i == 0)
+                float energy = 0.0f;
+                for (size_t j = range.binStart; j <= range.binEnd; ++j)
                 {
-                    lowerFreq = ISO_32_BAND_CENTERS[i] / sqrt2;
-                }
-                else
-                {
-                    lowerFreq = (ISO_32_BAND_CENTERS[i - 1] + ISO_32_BAND_CENTERS[i]) / 2.0f;
+                    energy += bandMagnitudes[j] * bandMagnitudes[j];
                 }
 
-                if (i == ISO_32_BAND_CENTERS.size() - 1)
-                {
-                    upperFreq = ISO_32_BAND_CENTERS[i] * sqrt2;
-                }
-                else
-                {
-                    upperFreq = (ISO_32_BAND_CENTERS[i] + ISO_32_BAND_CENTERS[i + 1]) / 2.0f;
-                }
+                // Amplitude of a sine carrying the band's power, see bandPowerScale.
+                saeBands[i] = std::sqrt(energy * plan.resolutions[range.resolution].bandPowerScale);
+                bandLevelsDb_[i] = amplitudeToDb(saeBands[i]);
+                saeBands[i] = normalizeDb(saeBands[i]);
+            }
 
-                size_t binStart = static_cast<size_t>(std::floor(lowerFreq / freqResolution));
-                size_t binEnd = static_cast<size_t>(std::ceil(upperFreq / freqResolution));
+            binData.totalBins = static_cast<uint16_t>(plan.size / 2);
+        }
 
-                binStart = std::min(binStart, fft_size_ - 1);
-                binEnd = std::min(binEnd, fft_size_ - 1);
+        // Fits a parabola through the log magnitudes around a local maximum, which for a Hann window
+        // places the true peak to within a few hundredths of a bin.
+        static float interpolatePeak(const std::vector<float>& magnitudes, size_t bin)
+        {
+            if (bin == 0 || bin + 1 >= magnitudes.size()) return static_cast<float>(bin);
 
-                saeBands[i] = 0.0f;
-                size_t count = 0;
+            const float alpha = std::log(magnitudes[bin - 1] + 1e-12f);
+            const float beta = std::log(magnitudes[bin] + 1e-12f);
+            const float gamma = std::log(magnitudes[bin + 1] + 1e-12f);
+            const float denominator = alpha - 2.0f * beta + gamma;
+            if (denominator >= 0.0f) return static_cast<float>(bin);
 
-                for (size_t j = binStart; j <= binEnd; ++j)
-                {
-                    saeBands[i] += magnitudes[j] * magnitudes[j]; // power
-                    ++count;
-                }
+            const float offset = 0.5f * (alpha - gamma) / denominator;
+            return static_cast<float>(bin) + std::clamp(offset, -0.5f, 0.5f);
+        }
+
+        // Harmonic product spectrum, summed in the log domain, refined with the same interpolation as the peak.
+        static float harmonicProductPitch(const std::vector<float>& magnitudes, float binResolution)
+        {
+            const size_t minBin = std::max<size_t>(1, static_cast<size_t>(std::ceil(HPS_MIN_FREQUENCY / binResolution)));
+            const size_t maxBin = std::min(static_cast<size_t>(HPS_MAX_FREQUENCY / binResolution), (magnitudes.size() - 1) / HPS_HARMONICS);
 
-                if (count > 0)
+            size_t bestBin = 0;
+            float bestScore = std::numeric_limits<float>::lowest();
+            for (size_t bin = minBin; bin <= maxBin; ++bin)
+            {
+                float score = 0.0f;
+                for (size_t harmonic = 1; harmonic <= HPS_HARMONICS; ++harmonic)
                 {
-                    // RMS
-                    saeBands[i] = std::sqrt(saeBands[i] / static_cast<float>(count));
-                    saeBands[i] = normalizeDb(saeBands[i]);
+                    score += std::log(magnitudes[bin * harmonic] + 1e-12f);
                 }
-                else
+                if (score > bestScore)
                 {
-                    saeBands[i] = 0.0f;
+                    bestScore = score;
+                    bestBin = bin;
                 }
             }
-
-            binData.totalBins = static_cast<uint16_t>(fft_size_ / 2);
-        }
-
-        static constexpr std::array<float, 32> ISO_32_BAND_CENTERS =
-        {
-            16, 20, 25, 31.5, 40, 50, 63, 80, 100, 125, 160, 200, 250, 315, 400, 500, 630,
-            800, 1000, 1250, 1600, 2000, 2500, 3150, 4000, 5000, 6300, 8000, 10000, 12500, 16000, 20000
-        };
-
-        double getFFTFrequency(int binIndex)
-        {
-            return (sampleRate_ / fft_size_) * binIndex;
+            return bestBin ? interpolatePeak(magnitudes, bestBin) * binResolution : 0.0f;
         }
 };
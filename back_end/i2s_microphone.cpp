@@ -1,4 +1,5 @@
 #include "i2s_microphone.h"
+#include "signals/SignalKeys.h"
 
 I2SMicrophone::I2SMicrophone( const std::string& targetDevice
                             , const std::string& signal_Name
@@ -17,11 +18,11 @@ I2SMicrophone::I2SMicrophone( const std::string& targetDevice
     , numFrames_(numFrames)
     , webSocketServer_(webSocketServer)
     , stopReading_(false)
-    , inputSignal_(std::dynamic_pointer_cast<Signal<std::vector<int32_t>>>(SignalManager::getInstance().getSharedSignalByName("Microphone")))
-    , inputSignalLeftChannel_(std::dynamic_pointer_cast<Signal<std::vector<int32_t>>>(SignalManager::getInstance().getSharedSignalByName("Microphone Left Channel")))
-    , inputSignalRightChannel_(std::dynamic_pointer_cast<Signal<std::vector<int32_t>>>(SignalManager::getInstance().getSharedSignalByName("Microphone Right Channel")))
-    , minDbSignal_(std::dynamic_pointer_cast<Signal<float>>(SignalManager::getInstance().getSharedSignalByName("Min db")))
-    , maxDbSignal_(std::dynamic_pointer_cast<Signal<float>>(SignalManager::getInstance().getSharedSignalByName("Max db")))
+    , inputSignal_(SignalManager::getInstance().getSignal(SignalKeys::Microphone))
+    , inputSignalLeftChannel_(SignalManager::getInstance().getSignal(SignalKeys::MicrophoneLeftChannel))
+    , inputSignalRightChannel_(SignalManager::getInstance().getSignal(SignalKeys::MicrophoneRightChannel))
+    , minDbSignal_(SignalManager::getInstance().getSignal(SignalKeys::MinDb))
+    , maxDbSignal_(SignalManager::getInstance().getSignal(SignalKeys::MaxDb))
 {
     // Retrieve existing logger or create a new one
     logger_ = initializeLogger("I2s Microphone", spdlog::level::info);
@@ -43,6 +44,7 @@ I2SMicrophone::I2SMicrophone( const std::string& targetDevice
         }
     }
 
+    // Trace logging walks every sample, so it runs off the capture thread and only sees the latest buffer.
     microphoneSignalCallback_ = [](const std::vector<int32_t>& value, void* arg)
     {
         I2SMicrophone* self = static_cast<I2SMicrophone*>(arg);
@@ -55,7 +57,7 @@ I2SMicrophone::I2SMicrophone( const std::string& targetDevice
     
     if (inputSignal_)
     {
-        inputSignal_->registerSignalValueCallback(microphoneSignalCallback_, this);
+        inputSignal_->registerSignalValueCallback(microphoneSignalCallback_, this, CallbackDispatch::LatestValue, "Microphone Diagnostics");
     }
     
     microphoneLeftChannelSignalCallback_ = [](const std::vector<int32_t>& value, void* arg)
@@ -70,7 +72,7 @@ I2SMicrophone::I2SMicrophone( const std::string& targetDevice
     
     if (inputSignalLeftChannel_)
     {
-        inputSignalLeftChannel_->registerSignalValueCallback(microphoneLeftChannelSignalCallback_, this);
+        inputSignalLeftChannel_->registerSignalValueCallback(microphoneLeftChannelSignalCallback_, this, CallbackDispatch::LatestValue, "Microphone Diagnostics");
     }
 
     microphoneRightChannelSignalCallback_ = [](const std::vector<int32_t>& value, void* arg)
@@ -85,7 +87,7 @@ I2SMicrophone::I2SMicrophone( const std::string& targetDevice
     
     if (inputSignalRightChannel_)
     {
-        inputSignalRightChannel_->registerSignalValueCallback(microphoneRightChannelSignalCallback_, this);
+        inputSignalRightChannel_->registerSignalValueCallback(microphoneRightChannelSignalCallback_, this, CallbackDispatch::LatestValue, "Microphone Diagnostics");
     }
 
     minDbSignalCallback_ = [](const float& value, void* arg)
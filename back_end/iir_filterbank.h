@@ -0,0 +1,286 @@
+#pragma once
+#include <vector>
+#include <array>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cmath>
+#include <algorithm>
+#include "logger.h"
+#include "analysis_engine.h"
+#include "stereo_capture_listener.h"
+#include "signals/SignalKeys.h"
+#include "websocket_server.h"
+
+// Low latency alternative to FFTComputer's band analysis. Every ISO band is a 4th order band pass
+// (two identical biquads) run directly on the capture stream, followed by a smoothed mean square.
+// Only listens to the capture stream, and only publishes the band signals, while "Analysis Engine" is
+// "IIR Filterbank". Mono is published from the mean power of both channels.
+class IIRFilterbank : public StereoCaptureListener
+{
+    public:
+        IIRFilterbank( const std::string name
+                     , const std::string input_signal_name
+                     , const std::string output_signal_name
+                     , unsigned int sampleRate
+                     , int32_t maxValue
+                     , std::shared_ptr<WebSocketServer> webSocketServer )
+            : StereoCaptureListener(name, input_signal_name, initializeLogger("IIR Filterbank", spdlog::level::info))
+            , name_(name)
+            , output_signal_name_(output_signal_name)
+            , sampleRate_(sampleRate)
+            , inputScale_(1.0 / static_cast<double>(maxValue))
+            , webSocketServer_(webSocketServer)
+            , logger_(initializeLogger("IIR Filterbank", spdlog::level::info))
+        {
+            buildFilters();
+            monoOutputSignal_->setWebSocketLayout(get_fft_bands_layout());
+            leftOutputSignal_->setWebSocketLayout(get_fft_bands_layout());
+            rightOutputSignal_->setWebSocketLayout(get_fft_bands_layout());
+
+            analysisEngineSignalCallback_ = [](const std::string& value, void* arg)
+            {
+                IIRFilterbank* self = static_cast<IIRFilterbank*>(arg);
+                try
+                {
+                    const AnalysisEngine engine = from_string<AnalysisEngine>(value);
+                    {
+                        std::lock_guard<std::mutex> lock(self->mutex_);
+                        if (engine == AnalysisEngine::IIRFilterbank && self->analysisEngine_ != AnalysisEngine::IIRFilterbank)
+                        {
+                            self->resetState();
+                        }
+                        self->analysisEngine_ = engine;
+                    }
+                    // Outside mutex_, stopping waits for a packet that may be in onStereoPacket.
+                    self->setListening(engine == AnalysisEngine::IIRFilterbank);
+                    self->logger_->info("IIR Filterbank: Received new Analysis Engine: {}", value);
+                }
+                catch (const std::exception& e)
+                {
+                    self->logger_->error("IIR Filterbank: Invalid Analysis Engine '{}': {}", value, e.what());
+                }
+            };
+
+            analysisEngineSignal_ = SignalManager::getInstance().getSignal(SignalKeys::AnalysisEngine);
+            if (analysisEngineSignal_)
+            {
+                analysisEngineSignal_->setValue(to_string(analysisEngine_.load()));
+                analysisEngineSignal_->registerSignalValueCallback(analysisEngineSignalCallback_, this);
+            }
+            else
+            {
+                logger_->warn("IIR Filterbank: Analysis Engine signal not found, using default value: {}", to_string(analysisEngine_.load()));
+            }
+
+            minDbSignalCallback_ = [](const float& value, void* arg)
+            {
+                static_cast<IIRFilterbank*>(arg)->minDbValue_ = value;
+            };
+            minDbSignal_ = SignalManager::getInstance().getSignal(SignalKeys::MinDb);
+            if (minDbSignal_)
+            {
+                minDbValue_ = minDbSignal_->getValue();
+                minDbSignal_->registerSignalValueCallback(minDbSignalCallback_, this);
+            }
+
+            maxDbSignalCallback_ = [](const float& value, void* arg)
+            {
+                static_cast<IIRFilterbank*>(arg)->maxDbValue_ = value;
+            };
+            maxDbSignal_ = SignalManager::getInstance().getSignal(SignalKeys::MaxDb);
+            if (maxDbSignal_)
+            {
+                maxDbValue_ = maxDbSignal_->getValue();
+                maxDbSignal_->registerSignalValueCallback(maxDbSignalCallback_, this);
+            }
+        }
+
+        ~IIRFilterbank()
+        {
+            stopListening();
+            if (analysisEngineSignal_) analysisEngineSignal_->unregisterSignalValueCallbackByArg(this);
+            if (minDbSignal_) minDbSignal_->unregisterSignalValueCallbackByArg(this);
+            if (maxDbSignal_) maxDbSignal_->unregisterSignalValueCallbackByArg(this);
+        }
+
+    protected:
+        void onStereoPacket(const std::vector<int32_t>& left, const std::vector<int32_t>& right) override
+        {
+            if (analysisEngine_ != AnalysisEngine::IIRFilterbank) return;
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            alignas(64) std::array<double, LANES> x;
+            for (size_t n = 0; n < left.size(); ++n)
+            {
+                std::fill(x.begin(), x.begin() + BANDS, left[n] * inputScale_);
+                std::fill(x.begin() + BANDS, x.end(), right[n] * inputScale_);
+
+                // Each loop runs over all 64 band/channel lanes with no dependency between them.
+                for (size_t s = 0; s < SECTIONS_PER_BAND; ++s)
+                {
+                    Section& section = sections_[s];
+                    for (size_t lane = 0; lane < LANES; ++lane)
+                    {
+                        const double y = section.b0[lane] * x[lane] + section.z1[lane];
+                        section.z1[lane] = section.b1[lane] * x[lane] - section.a1[lane] * y + section.z2[lane];
+                        section.z2[lane] = section.b2[lane] * x[lane] - section.a2[lane] * y;
+                        x[lane] = y;
+                    }
+                }
+                for (size_t lane = 0; lane < LANES; ++lane)
+                {
+                    meanSquare_[lane] += smoothing_[lane] * (x[lane] * x[lane] - meanSquare_[lane]);
+                }
+            }
+            publishBands();
+        }
+
+    private:
+        static constexpr size_t BANDS = ISO_32_BAND_CENTERS.size();
+        static constexpr size_t CHANNELS = 2;
+        static constexpr size_t LANES = BANDS * CHANNELS;     // lane = channel * BANDS + band
+        static constexpr size_t SECTIONS_PER_BAND = 2;
+        static constexpr double MINIMUM_SMOOTHING_SECONDS = 0.005;
+        static constexpr double SMOOTHING_PERIODS = 2.0;
+        // Scales a full scale sine to the level FFTComputer reports for it at 8192 points, so Min db / Max db
+        // read about the same with either engine.
+        static constexpr double REFERENCE_FFT_SIZE = 8192.0;
+
+        // Structure of arrays, coefficients are repeated for each channel so every lane is independent.
+        struct Section
+        {
+            alignas(64) std::array<double, LANES> b0 = {};
+            alignas(64) std::array<double, LANES> b1 = {};
+            alignas(64) std::array<double, LANES> b2 = {};
+            alignas(64) std::array<double, LANES> a1 = {};
+            alignas(64) std::array<double, LANES> a2 = {};
+            alignas(64) std::array<double, LANES> z1 = {};
+            alignas(64) std::array<double, LANES> z2 = {};
+        };
+
+        std::string name_;
+        std::string output_signal_name_;
+        unsigned int sampleRate_;
+        double inputScale_;
+        std::shared_ptr<WebSocketServer> webSocketServer_;
+        std::shared_ptr<spdlog::logger> logger_;
+        std::mutex mutex_;
+
+        std::array<Section, SECTIONS_PER_BAND> sections_;
+        alignas(64) std::array<double, LANES> smoothing_ = {};
+        alignas(64) std::array<double, LANES> meanSquare_ = {};
+        std::vector<float> monoBands_ = std::vector<float>(BANDS, 0.0f);
+        std::vector<float> leftBands_ = std::vector<float>(BANDS, 0.0f);
+        std::vector<float> rightBands_ = std::vector<float>(BANDS, 0.0f);
+        SignalBatch batch_;     // Reused every block, guarded by mutex_
+
+        std::atomic<AnalysisEngine> analysisEngine_{AnalysisEngine::FFT};
+        std::mutex listeningMutex_;
+        bool listening_ = false;        // Guarded by listeningMutex_
+        std::shared_ptr<Signal<std::string>> analysisEngineSignal_;
+        std::function<void(const std::string&, void*)> analysisEngineSignalCallback_;
+
+        std::atomic<float> minDbValue_{0.0f};
+        std::atomic<float> maxDbValue_{40.0f};
+        std::shared_ptr<Signal<float>> minDbSignal_;
+        std::shared_ptr<Signal<float>> maxDbSignal_;
+        std::function<void(const float&, void*)> minDbSignalCallback_;
+        std::function<void(const float&, void*)> maxDbSignalCallback_;
+
+        std::shared_ptr<Signal<std::vector<float>>> monoOutputSignal_ = SignalManager::getInstance().createSignal<std::vector<float>>(output_signal_name_, webSocketServer_, get_band_vector_encoder());
+        std::shared_ptr<Signal<std::vector<float>>> leftOutputSignal_ = SignalManager::getInstance().createSignal<std::vector<float>>(output_signal_name_ + " Left Channel", webSocketServer_, get_band_vector_encoder());
+        std::shared_ptr<Signal<std::vector<float>>> rightOutputSignal_ = SignalManager::getInstance().createSignal<std::vector<float>>(output_signal_name_ + " Right Channel", webSocketServer_, get_band_vector_encoder());
+
+        void publishBands()
+        {
+            const float minDb = minDbValue_;
+            const float maxDb = maxDbValue_;
+            for (size_t band = 0; band < BANDS; ++band)
+            {
+                monoBands_[band] = normalizeDb(0.5 * (meanSquare_[band] + meanSquare_[BANDS + band]), minDb, maxDb);
+                leftBands_[band] = normalizeDb(meanSquare_[band], minDb, maxDb);
+                rightBands_[band] = normalizeDb(meanSquare_[BANDS + band], minDb, maxDb);
+            }
+            // One commit, subscribers never see the mono bands of one block with the channel bands of another.
+            batch_.set(monoOutputSignal_, monoBands_);
+            batch_.set(leftOutputSignal_, leftBands_);
+            batch_.set(rightOutputSignal_, rightBands_);
+            SignalManager::getInstance().commit(batch_);
+        }
+
+        // Pairing and copying the capture packets costs even when they are ignored, so the listener is only
+        // registered while this engine is selected.
+        void setListening(bool listening)
+        {
+            std::lock_guard<std::mutex> lock(listeningMutex_);
+            if (listening == listening_)
+            {
+                return;
+            }
+            if (listening)
+            {
+                startListening();
+            }
+            else
+            {
+                stopListening();
+            }
+            listening_ = listening;
+        }
+
+        static float normalizeDb(double meanSquare, float minDb, float maxDb)
+        {
+            // Peak amplitude of a sine with this mean square, at the FFT's reference level.
+            const double amplitude = std::sqrt(2.0 * meanSquare) * REFERENCE_FFT_SIZE / 2.0;
+            const float db = static_cast<float>(20.0 * std::log10(amplitude + 1e-6));
+            return std::clamp((db - minDb) / (maxDb - minDb), 0.0f, 1.0f);
+        }
+
+        void resetState()
+        {
+            for (Section& section : sections_)
+            {
+                section.z1.fill(0.0);
+                section.z2.fill(0.0);
+            }
+            meanSquare_.fill(0.0);
+        }
+
+        // RBJ constant peak gain band pass. Cascading two sections squares the response, so each section's Q is
+        // lowered by sqrt(sqrt(2) - 1) to keep the -3 dB points on the band edges.
+        void buildFilters()
+        {
+            const double nyquist = sampleRate_ / 2.0;
+            for (size_t band = 0; band < BANDS; ++band)
+            {
+                const auto [lowerFreq, upperFreq] = isoBandEdges(band);
+                const double center = std::min<double>(ISO_32_BAND_CENTERS[band], 0.9 * nyquist);
+                const double q = center / (std::min<double>(upperFreq, nyquist) - lowerFreq) * std::sqrt(std::sqrt(2.0) - 1.0);
+                const double w0 = 2.0 * M_PI * center / sampleRate_;
+                const double alpha = std::sin(w0) / (2.0 * q);
+                const double a0 = 1.0 + alpha;
+
+                const double periodSeconds = 1.0 / center;
+                const double smoothingSeconds = std::max(MINIMUM_SMOOTHING_SECONDS, SMOOTHING_PERIODS * periodSeconds);
+                const double smoothing = 1.0 - std::exp(-1.0 / (smoothingSeconds * sampleRate_));
+
+                for (size_t channel = 0; channel < CHANNELS; ++channel)
+                {
+                    const size_t lane = channel * BANDS + band;
+                    for (Section& section : sections_)
+                    {
+                        section.b0[lane] = alpha / a0;
+                        section.b1[lane] = 0.0;
+                        section.b2[lane] = -alpha / a0;
+                        section.a1[lane] = -2.0 * std::cos(w0) / a0;
+                        section.a2[lane] = (1.0 - alpha) / a0;
+                    }
+                    smoothing_[lane] = smoothing;
+                }
+            }
+            resetState();
+            logger_->info("Device {}: {} band IIR filterbank ready at {} Hz", name_, BANDS, sampleRate_);
+        }
+};
@@ -1,5 +1,6 @@
 #include "led_controller.h"
 #include "logger.h"
+#include "signals/SignalKeys.h"
 #include <fcntl.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
@@ -13,9 +14,9 @@
 LED_Controller::LED_Controller(int ledCount)
     : ledCount_(ledCount)
     , logger_(initializeLogger("LED Logger", spdlog::level::info))
-    , calculatedCurrentSignal_(std::dynamic_pointer_cast<Signal<float>>(SignalManager::getInstance().getSharedSignalByName("Calculated Current")))
-    , currentLimitSignal_(std::dynamic_pointer_cast<Signal<uint32_t>>(SignalManager::getInstance().getSharedSignalByName("Current Limit")))
-    , globalLedDriverLimitSignal_(std::dynamic_pointer_cast<Signal<uint8_t>>(SignalManager::getInstance().getSharedSignalByName("LED Driver Limit")))
+    , calculatedCurrentSignal_(SignalManager::getInstance().getSignal(SignalKeys::CalculatedCurrent))
+    , currentLimitSignal_(SignalManager::getInstance().getSignal(SignalKeys::CurrentLimit))
+    , globalLedDriverLimitSignal_(SignalManager::getInstance().getSignal(SignalKeys::LEDDriverLimit))
     , running_(false)
     , render_in_progress_(false)
     , ledStrip_(ledCount)
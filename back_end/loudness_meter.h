@@ -0,0 +1,383 @@
+#pragma once
+#include <vector>
+#include <array>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cmath>
+#include <algorithm>
+#include <complex>
+#include "logger.h"
+#include "stereo_capture_listener.h"
+#include "signals/SignalKeys.h"
+#include "websocket_server.h"
+
+enum class LoudnessWeighting
+{
+    KWeighting,
+    AWeighting
+};
+
+inline std::string to_string(LoudnessWeighting weighting)
+{
+    switch (weighting)
+    {
+        case LoudnessWeighting::KWeighting: return "K Weighting";
+        case LoudnessWeighting::AWeighting: return "A Weighting";
+        default: throw std::invalid_argument("Unknown LoudnessWeighting");
+    }
+}
+
+inline std::ostream& operator<<(std::ostream& os, LoudnessWeighting weighting)
+{
+    os << to_string(weighting);
+    return os;
+}
+
+inline std::istream& operator>>(std::istream& is, LoudnessWeighting& weighting)
+{
+    std::string token;
+    std::getline(is >> std::ws, token);
+
+    if (token == "K Weighting")      weighting = LoudnessWeighting::KWeighting;
+    else if (token == "A Weighting") weighting = LoudnessWeighting::AWeighting;
+    else                             is.setstate(std::ios::failbit);
+
+    return is;
+}
+
+// ITU-R BS.1770 style loudness of the stereo capture: weighted mean square over 400 ms (momentary)
+// and 3 s (short term) windows, plus a 4x oversampled true peak. Published every 100 ms block.
+class LoudnessMeter : public StereoCaptureListener
+{
+    public:
+        LoudnessMeter( const std::string name
+                     , const std::string input_signal_name
+                     , const std::string output_signal_name
+                     , unsigned int sampleRate
+                     , int32_t maxValue
+                     , std::shared_ptr<WebSocketServer> webSocketServer )
+            : StereoCaptureListener(name, input_signal_name, initializeLogger("Loudness Meter", spdlog::level::info))
+            , name_(name)
+            , output_signal_name_(output_signal_name)
+            , sampleRate_(sampleRate)
+            , inputScale_(1.0 / static_cast<double>(maxValue))
+            , webSocketServer_(webSocketServer)
+            , samplesPerBlock_(std::max<size_t>(1, sampleRate / BLOCKS_PER_SECOND))
+            , logger_(initializeLogger("Loudness Meter", spdlog::level::info))
+        {
+            buildWeightingFilters(weighting_);
+            buildTruePeakFilter();
+
+            weightingSignalCallback_ = [](const std::string& value, void* arg)
+            {
+                LoudnessMeter* self = static_cast<LoudnessMeter*>(arg);
+                try
+                {
+                    const LoudnessWeighting weighting = from_string<LoudnessWeighting>(value);
+                    std::lock_guard<std::mutex> lock(self->mutex_);
+                    self->buildWeightingFilters(weighting);
+                    self->logger_->info("Loudness Meter: Received new Loudness Weighting: {}", value);
+                }
+                catch (const std::exception& e)
+                {
+                    self->logger_->error("Loudness Meter: Invalid Loudness Weighting '{}': {}", value, e.what());
+                }
+            };
+
+            weightingSignal_ = SignalManager::getInstance().getSignal(SignalKeys::LoudnessWeighting);
+            if (weightingSignal_)
+            {
+                weightingSignal_->setValue(to_string(weighting_));
+                weightingSignal_->registerSignalValueCallback(weightingSignalCallback_, this);
+            }
+            else
+            {
+                logger_->warn("Loudness Meter: Loudness Weighting signal not found, using default value: {}", to_string(weighting_));
+            }
+
+            startListening();
+        }
+
+        ~LoudnessMeter()
+        {
+            stopListening();
+            if (weightingSignal_) weightingSignal_->unregisterSignalValueCallbackByArg(this);
+        }
+
+    protected:
+        void onStereoPacket(const std::vector<int32_t>& left, const std::vector<int32_t>& right) override
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (size_t n = 0; n < left.size(); ++n)
+            {
+                Frame x = { left[n] * inputScale_, right[n] * inputScale_ };
+                updateTruePeak(x);
+
+                for (size_t s = 0; s < sectionCount_; ++s)
+                {
+                    x = sections_[s].process(x, state_[s]);
+                }
+                for (size_t c = 0; c < CHANNEL_COUNT; ++c)
+                {
+                    blockSumSquares_[c] += x[c] * x[c];
+                }
+
+                if (++blockSamples_ == samplesPerBlock_)
+                {
+                    completeBlock();
+                }
+            }
+        }
+
+    private:
+        static constexpr size_t CHANNEL_COUNT = 2;
+        static constexpr size_t BLOCKS_PER_SECOND = 10;
+        static constexpr size_t MOMENTARY_BLOCKS = 4;     // 400 ms
+        static constexpr size_t SHORT_TERM_BLOCKS = 30;   // 3 s
+        static constexpr size_t MAX_SECTIONS = 3;
+        static constexpr size_t OVERSAMPLING = 4;
+        static constexpr size_t TAPS_PER_PHASE = 12;
+        static constexpr float SILENCE_DB = -120.0f;
+
+        // Both channels are held side by side and every filter loops over them innermost,
+        // so each stage runs as one two lane operation per sample.
+        using Frame = std::array<double, CHANNEL_COUNT>;
+
+        struct BiquadState
+        {
+            Frame z1 = {};
+            Frame z2 = {};
+        };
+
+        // Transposed direct form II, shared coefficients for every channel.
+        struct Biquad
+        {
+            double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+
+            Frame process(const Frame& x, BiquadState& state) const
+            {
+                Frame y;
+                for (size_t c = 0; c < CHANNEL_COUNT; ++c)
+                {
+                    y[c] = b0 * x[c] + state.z1[c];
+                    state.z1[c] = b1 * x[c] - a1 * y[c] + state.z2[c];
+                    state.z2[c] = b2 * x[c] - a2 * y[c];
+                }
+                return y;
+            }
+        };
+
+        std::string name_;
+        std::string output_signal_name_;
+        unsigned int sampleRate_;
+        double inputScale_;
+        std::shared_ptr<WebSocketServer> webSocketServer_;
+        const size_t samplesPerBlock_;
+        std::shared_ptr<spdlog::logger> logger_;
+        std::mutex mutex_;
+
+        LoudnessWeighting weighting_ = LoudnessWeighting::KWeighting;
+        std::array<Biquad, MAX_SECTIONS> sections_;
+        std::array<BiquadState, MAX_SECTIONS> state_;
+        size_t sectionCount_ = 0;
+
+        Frame blockSumSquares_ = {};
+        size_t blockSamples_ = 0;
+        std::array<Frame, SHORT_TERM_BLOCKS> blockMeans_ = {};
+        size_t blockIndex_ = 0;
+        size_t blocksSeen_ = 0;
+
+        std::array<double, OVERSAMPLING * TAPS_PER_PHASE> truePeakTaps_ = {};
+        std::array<Frame, TAPS_PER_PHASE> truePeakHistory_ = {};
+        size_t truePeakHistoryIndex_ = 0;
+        Frame truePeak_ = {};
+
+        std::shared_ptr<Signal<float>> momentarySignal_ = SignalManager::getInstance().createSignal<float>(output_signal_name_ + " Momentary", webSocketServer_, get_signal_and_value_encoder<float>());
+        std::shared_ptr<Signal<float>> shortTermSignal_ = SignalManager::getInstance().createSignal<float>(output_signal_name_ + " Short Term", webSocketServer_, get_signal_and_value_encoder<float>());
+        std::shared_ptr<Signal<float>> truePeakLeftSignal_ = SignalManager::getInstance().createSignal<float>(output_signal_name_ + " True Peak Left", webSocketServer_, get_signal_and_value_encoder<float>());
+        std::shared_ptr<Signal<float>> truePeakRightSignal_ = SignalManager::getInstance().createSignal<float>(output_signal_name_ + " True Peak Right", webSocketServer_, get_signal_and_value_encoder<float>());
+
+        std::shared_ptr<Signal<std::string>> weightingSignal_;
+        std::function<void(const std::string&, void*)> weightingSignalCallback_;
+
+        void completeBlock()
+        {
+            for (size_t c = 0; c < CHANNEL_COUNT; ++c)
+            {
+                blockMeans_[blockIndex_][c] = blockSumSquares_[c] / static_cast<double>(blockSamples_);
+            }
+            blockIndex_ = (blockIndex_ + 1) % SHORT_TERM_BLOCKS;
+            blocksSeen_ = std::min(blocksSeen_ + 1, SHORT_TERM_BLOCKS);
+            blockSumSquares_ = {};
+            blockSamples_ = 0;
+
+            momentarySignal_->setValue(windowLoudness(MOMENTARY_BLOCKS));
+            shortTermSignal_->setValue(windowLoudness(SHORT_TERM_BLOCKS));
+            truePeakLeftSignal_->setValue(toDb(truePeak_[0]));
+            truePeakRightSignal_->setValue(toDb(truePeak_[1]));
+            truePeak_ = {};
+        }
+
+        // Channel weights are 1.0 for left and right, the -0.691 offset makes a full scale 997 Hz sine in one channel read -3.01 LUFS.
+        float windowLoudness(size_t blocks) const
+        {
+            const size_t count = std::min(blocks, blocksSeen_);
+            if (count == 0) return SILENCE_DB;
+
+            double sum = 0.0;
+            for (size_t i = 1; i <= count; ++i)
+            {
+                const Frame& mean = blockMeans_[(blockIndex_ + SHORT_TERM_BLOCKS - i) % SHORT_TERM_BLOCKS];
+                for (size_t c = 0; c < CHANNEL_COUNT; ++c)
+                {
+                    sum += mean[c];
+                }
+            }
+            const double meanSquare = sum / static_cast<double>(count);
+            if (meanSquare <= 0.0) return SILENCE_DB;
+            const double offset = weighting_ == LoudnessWeighting::KWeighting ? -0.691 : 0.0;
+            return std::max(SILENCE_DB, static_cast<float>(offset + 10.0 * std::log10(meanSquare)));
+        }
+
+        static float toDb(double amplitude)
+        {
+            return amplitude > 0.0 ? std::max(SILENCE_DB, static_cast<float>(20.0 * std::log10(amplitude))) : SILENCE_DB;
+        }
+
+        // 4x polyphase interpolation as described in BS.1770 Annex 2, the largest interpolated sample is the true peak.
+        void updateTruePeak(const Frame& x)
+        {
+            truePeakHistoryIndex_ = (truePeakHistoryIndex_ + TAPS_PER_PHASE - 1) % TAPS_PER_PHASE;
+            truePeakHistory_[truePeakHistoryIndex_] = x;
+
+            for (size_t phase = 0; phase < OVERSAMPLING; ++phase)
+            {
+                Frame y = {};
+                for (size_t k = 0; k < TAPS_PER_PHASE; ++k)
+                {
+                    const double tap = truePeakTaps_[phase + k * OVERSAMPLING];
+                    const Frame& sample = truePeakHistory_[(truePeakHistoryIndex_ + k) % TAPS_PER_PHASE];
+                    for (size_t c = 0; c < CHANNEL_COUNT; ++c)
+                    {
+                        y[c] += tap * sample[c];
+                    }
+                }
+                for (size_t c = 0; c < CHANNEL_COUNT; ++c)
+                {
+                    truePeak_[c] = std::max(truePeak_[c], std::abs(y[c]));
+                }
+            }
+        }
+
+        // Hann windowed sinc low pass at the original Nyquist, scaled so every phase has unity DC gain.
+        void buildTruePeakFilter()
+        {
+            const size_t tapCount = truePeakTaps_.size();
+            const double center = (tapCount - 1) / 2.0;
+            for (size_t n = 0; n < tapCount; ++n)
+            {
+                const double t = (n - center) / OVERSAMPLING;
+                const double sinc = t == 0.0 ? 1.0 : std::sin(M_PI * t) / (M_PI * t);
+                const double window = 0.5 * (1.0 - std::cos(2.0 * M_PI * (n + 0.5) / tapCount));
+                truePeakTaps_[n] = sinc * window;
+            }
+            for (size_t phase = 0; phase < OVERSAMPLING; ++phase)
+            {
+                double sum = 0.0;
+                for (size_t k = 0; k < TAPS_PER_PHASE; ++k) sum += truePeakTaps_[phase + k * OVERSAMPLING];
+                for (size_t k = 0; k < TAPS_PER_PHASE; ++k) truePeakTaps_[phase + k * OVERSAMPLING] /= sum;
+            }
+        }
+
+        // Bilinear transform of the analog section (b2 s^2 + b1 s + b0) / (a2 s^2 + a1 s + a0).
+        Biquad bilinear(double b2, double b1, double b0, double a2, double a1, double a0) const
+        {
+            const double k = 2.0 * sampleRate_;
+            const double k2 = k * k;
+            const double norm = a2 * k2 + a1 * k + a0;
+            Biquad biquad;
+            biquad.b0 = (b2 * k2 + b1 * k + b0) / norm;
+            biquad.b1 = (2.0 * b0 - 2.0 * b2 * k2) / norm;
+            biquad.b2 = (b2 * k2 - b1 * k + b0) / norm;
+            biquad.a1 = (2.0 * a0 - 2.0 * a2 * k2) / norm;
+            biquad.a2 = (a2 * k2 - a1 * k + a0) / norm;
+            return biquad;
+        }
+
+        double gainAt(double frequency) const
+        {
+            const double w = 2.0 * M_PI * frequency / sampleRate_;
+            std::complex<double> z1 = std::polar(1.0, -w);
+            std::complex<double> response = 1.0;
+            for (size_t s = 0; s < sectionCount_; ++s)
+            {
+                const Biquad& q = sections_[s];
+                response *= (q.b0 + q.b1 * z1 + q.b2 * z1 * z1) / (1.0 + q.a1 * z1 + q.a2 * z1 * z1);
+            }
+            return std::abs(response);
+        }
+
+        void buildWeightingFilters(LoudnessWeighting weighting)
+        {
+            weighting_ = weighting;
+            sections_.fill(Biquad());
+            state_.fill(BiquadState());
+
+            switch (weighting)
+            {
+                case LoudnessWeighting::AWeighting:
+                {
+                    // IEC 61672 poles, one biquad per pole pair, normalized to 0 dB at 1 kHz.
+                    // Poles are prewarped so the 12.2 kHz roll off stays within class 1 tolerance at 48 kHz.
+                    auto prewarp = [this](double frequency) { return 2.0 * sampleRate_ * std::tan(M_PI * frequency / sampleRate_); };
+                    const double w1 = prewarp(20.598997);
+                    const double w2 = prewarp(107.65265);
+                    const double w3 = prewarp(737.86223);
+                    const double w4 = prewarp(12194.217);
+                    sections_[0] = bilinear(1.0, 0.0, 0.0, 1.0, 2.0 * w1, w1 * w1);
+                    sections_[1] = bilinear(1.0, 0.0, 0.0, 1.0, w2 + w3, w2 * w3);
+                    sections_[2] = bilinear(0.0, 0.0, w4 * w4, 1.0, 2.0 * w4, w4 * w4);
+                    sectionCount_ = 3;
+                    const double gain = 1.0 / gainAt(1000.0);
+                    sections_[0].b0 *= gain;
+                    sections_[0].b1 *= gain;
+                    sections_[0].b2 *= gain;
+                }
+                break;
+                case LoudnessWeighting::KWeighting:
+                default:
+                {
+                    // BS.1770 pre filter (high shelf) and RLB high pass, derived for any sample rate.
+                    // At 48 kHz these reproduce the coefficients tabulated in the recommendation.
+                    const double shelfFrequency = 1681.974450955533;
+                    const double shelfGainDb = 3.999843853973347;
+                    const double shelfQ = 0.7071752369554196;
+                    const double highPassFrequency = 38.13547087602444;
+                    const double highPassQ = 0.5003270373238773;
+
+                    double k = std::tan(M_PI * shelfFrequency / sampleRate_);
+                    const double vh = std::pow(10.0, shelfGainDb / 20.0);
+                    const double vb = std::pow(vh, 0.4996667741545416);
+                    double a0 = 1.0 + k / shelfQ + k * k;
+                    sections_[0].b0 = (vh + vb * k / shelfQ + k * k) / a0;
+                    sections_[0].b1 = 2.0 * (k * k - vh) / a0;
+                    sections_[0].b2 = (vh - vb * k / shelfQ + k * k) / a0;
+                    sections_[0].a1 = 2.0 * (k * k - 1.0) / a0;
+                    sections_[0].a2 = (1.0 - k / shelfQ + k * k) / a0;
+
+                    k = std::tan(M_PI * highPassFrequency / sampleRate_);
+                    a0 = 1.0 + k / highPassQ + k * k;
+                    sections_[1].b0 = 1.0;
+                    sections_[1].b1 = -2.0;
+                    sections_[1].b2 = 1.0;
+                    sections_[1].a1 = 2.0 * (k * k - 1.0) / a0;
+                    sections_[1].a2 = (1.0 - k / highPassQ + k * k) / a0;
+                    sectionCount_ = 2;
+                }
+                break;
+            }
+            logger_->info("Device {}: Using {} at {} Hz", name_, to_string(weighting_), sampleRate_);
+        }
+};
@@ -1,14 +1,22 @@
 #include <iostream>
 #include <sstream>
+#include <cstdlib>
+#include <cmath>
 #include "i2s_microphone.h"
 #include "fft_computer.h"
+#include "loudness_meter.h"
+#include "stereo_analyzer.h"
+#include "iir_filterbank.h"
 #include "websocket_server.h"
 #include "deployment_manager.h"
 #include "logger.h"
 #include "SystemStatusMonitor.h"
+#include "SignalStatsMonitor.h"
 #include "signals/SignalFactory.h"
 #include "signals/signal.h"
 #include "signals/PixelGridSignal.h"
+#include "signals/SignalRecorder.h"
+#include "signals/SignalReplay.h"
 #include "./animation/FFTAnimation.h"
 #include "./animation/RainbowAnimation.h"
 
@@ -21,21 +29,84 @@ int main()
     SignalFactory::CreateSignals(webSocketServer);
     auto mic = std::make_shared<I2SMicrophone>("snd_rpi_googlevoicehat_soundcar", "Microphone", 48000, 2, 1024, SND_PCM_FORMAT_S24_LE, SND_PCM_ACCESS_RW_INTERLEAVED, true, 200000, webSocketServer);
     auto fftComputer = std::make_shared<FFTComputer>("FFT Computer", "Microphone", "FFT Bands", 8192, 48000, (1 << 23) - 1, webSocketServer);
+    auto iirFilterbank = std::make_shared<IIRFilterbank>("IIR Filterbank", "Microphone", "FFT Bands", 48000, (1 << 23) - 1, webSocketServer);
+    auto loudnessMeter = std::make_shared<LoudnessMeter>("Loudness Meter", "Microphone", "Loudness", 48000, (1 << 23) - 1, webSocketServer);
+    auto stereoAnalyzer = std::make_shared<StereoAnalyzer>("Stereo Analyzer", "Microphone", "Stereo Field", webSocketServer);
     auto deploymentManger = std::make_shared<DeploymentManager>();
     auto systemStatusMonitor = std::make_shared<SystemStatusMonitor>(webSocketServer);
+    auto signalStatsMonitor = std::make_shared<SignalStatsMonitor>();
 
     deploymentManger->clearFolderContentsWithSudo("/var/www/html");
     deploymentManger->copyFolderContentsWithSudo("./www", "/var/www/html");
     webSocketServer->start();
-    mic->startReadingMicrophone();
+
+    // Debug capture and offline reproduction, both off unless configured. A replay stands in for the microphone.
+    std::unique_ptr<SignalReplay> replay;
+    if (const char* replayPath = std::getenv("SIGNAL_REPLAY_PATH"))
+    {
+        float speed = 1.0f;
+        if (const char* replaySpeed = std::getenv("SIGNAL_REPLAY_SPEED"))
+        {
+            char* end = nullptr;
+            const float parsed = std::strtof(replaySpeed, &end);
+            if (end != replaySpeed && *end == '\0' && std::isfinite(parsed) && parsed > 0.0f)
+            {
+                speed = parsed;
+            }
+            else
+            {
+                logger_->warn("Invalid SIGNAL_REPLAY_SPEED '{}', expected a number above 0. Replaying at 1x.", replaySpeed);
+            }
+        }
+        replay = std::make_unique<SignalReplay>(replayPath, speed);
+        replay->start();
+    }
+    else
+    {
+        mic->startReadingMicrophone();
+    }
+
+    std::unique_ptr<SignalRecorder> recorder;
+    if (const char* recordDirectory = std::getenv("SIGNAL_RECORD_DIR"))
+    {
+        std::vector<std::string> recordedSignals = { SignalKeys::Microphone.name, SignalKeys::MicrophoneLeftChannel.name, SignalKeys::MicrophoneRightChannel.name };
+        if (const char* recordSignals = std::getenv("SIGNAL_RECORD_SIGNALS"))
+        {
+            recordedSignals.clear();
+            std::stringstream names(recordSignals);
+            std::string name;
+            while (std::getline(names, name, ','))
+            {
+                recordedSignals.push_back(name);
+            }
+        }
+        recorder = std::make_unique<SignalRecorder>(recordDirectory, recordedSignals);
+        recorder->start();
+    }
+
     systemStatusMonitor->startMonitoring();
+    signalStatsMonitor->startMonitoring();
     PixelGridSignal grid("Pixel Grid", 5, 144, webSocketServer);
     RainbowAnimation animation(grid);
     animation.Start();
 
-    std::cin.get();
+    // "stats" logs every signal's counters, any other line quits.
+    std::string command;
+    while (std::getline(std::cin, command) && command == "stats")
+    {
+        SignalManager::getInstance().dumpStats();
+    }
 
     animation.stop();
+    signalStatsMonitor->stopMonitoring();
+    if (recorder)
+    {
+        recorder->stop();
+    }
+    if (replay)
+    {
+        replay->stop();
+    }
     webSocketServer->stop();
     return 0;
 }
\ No newline at end of file
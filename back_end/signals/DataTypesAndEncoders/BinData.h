@@ -10,6 +10,9 @@ struct BinData
     uint16_t totalBins = 0;
     float normalizedMinValue = 0.0;
     float normalizedMaxValue = 0.0;
+    float peakBin = 0.0f;          // maxBin refined by parabolic interpolation
+    float peakFrequency = 0.0f;    // Hz
+    float pitchFrequency = 0.0f;   // Hz from the harmonic product spectrum, 0 when disabled or not found
 
     bool operator==(const BinData& other) const
     {
@@ -17,7 +20,10 @@ struct BinData
             maxBin == other.maxBin &&
             totalBins == other.totalBins &&
             normalizedMinValue == other.normalizedMinValue &&
-            normalizedMaxValue == other.normalizedMaxValue;
+            normalizedMaxValue == other.normalizedMaxValue &&
+            peakBin == other.peakBin &&
+            peakFrequency == other.peakFrequency &&
+            pitchFrequency == other.pitchFrequency;
     }
 
     bool operator!=(const BinData& other) const
@@ -34,7 +40,10 @@ inline void to_json(json& j, const BinData& data)
         {"maxBin", data.maxBin},
         {"totalBins", data.totalBins},
         {"normalizeMinValue", data.normalizedMinValue},
-        {"normalizeMaxValue", data.normalizedMaxValue}
+        {"normalizeMaxValue", data.normalizedMaxValue},
+        {"peakBin", data.peakBin},
+        {"peakFrequency", data.peakFrequency},
+        {"pitchFrequency", data.pitchFrequency}
     };
 }
 
@@ -45,6 +54,10 @@ inline void from_json(const json& j, BinData& data)
     j.at("totalBins").get_to(data.totalBins);
     j.at("normalizeMinValue").get_to(data.normalizedMinValue);
     j.at("normalizeMaxValue").get_to(data.normalizedMaxValue);
+    // Added later, JSON written before them (recordings, echoes from older clients) still reads.
+    data.peakBin = j.value("peakBin", 0.0f);
+    data.peakFrequency = j.value("peakFrequency", 0.0f);
+    data.pitchFrequency = j.value("pitchFrequency", 0.0f);
 }
 
 inline std::ostream& operator<<(std::ostream& os, const BinData& data)
@@ -54,6 +67,9 @@ inline std::ostream& operator<<(std::ostream& os, const BinData& data)
        << ", totalBins=" << data.totalBins
        << ", normalizedMinValue=" << data.normalizedMinValue
        << ", normalizedMaxValue=" << data.normalizedMaxValue
+       << ", peakBin=" << data.peakBin
+       << ", peakFrequency=" << data.peakFrequency
+       << ", pitchFrequency=" << data.pitchFrequency
        << "}";
     return os;
 }
@@ -66,7 +82,7 @@ inline std::istream& operator>>(std::istream& is, BinData& data)
     std::string token;
 
     // Expected format:
-    // BinData{minBin=..., maxBin=..., totalBins=..., minValue=..., maxValue=...}
+    // BinData{minBin=..., maxBin=..., totalBins=..., minValue=..., maxValue=..., peakBin=..., peakFrequency=..., pitchFrequency=...}
 
     // Read and validate "BinData{"
     if (!(is >> token) || token.substr(0, 8) != "BinData{")
@@ -115,7 +131,10 @@ inline std::istream& operator>>(std::istream& is, BinData& data)
     if (!parseKeyValue("maxBin", data.maxBin)) { is.setstate(std::ios::failbit); return is; }
     if (!parseKeyValue("totalBins", data.totalBins)) { is.setstate(std::ios::failbit); return is; }
     if (!parseKeyValue("normalizeMinValue", data.normalizedMinValue)) { is.setstate(std::ios::failbit); return is; }
-    if (!parseKeyValue("normalizeMaxValue", data.normalizedMaxValue, true)) { is.setstate(std::ios::failbit); return is; }
+    if (!parseKeyValue("normalizeMaxValue", data.normalizedMaxValue)) { is.setstate(std::ios::failbit); return is; }
+    if (!parseKeyValue("peakBin", data.peakBin)) { is.setstate(std::ios::failbit); return is; }
+    if (!parseKeyValue("peakFrequency", data.peakFrequency)) { is.setstate(std::ios::failbit); return is; }
+    if (!parseKeyValue("pitchFrequency", data.pitchFrequency, true)) { is.setstate(std::ios::failbit); return is; }
 
     return is;
 }
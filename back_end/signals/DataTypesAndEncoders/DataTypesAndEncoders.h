@@ -2,6 +2,9 @@
 #pragma once
 
 #include "BinData.h"
+#include "SpectrumColumn.h"
+#include "StereoField.h"
+#include "SignalStatsEntry.h"
 #include "Point.h"
 #include "Encoder_Binary.h"
 #include "Encoder_Json.h"
@@ -93,20 +96,72 @@ inline std::string encode_signal_name_and_json(const std::string& signal, const
     return j.dump();
 }
 
+inline const std::vector<std::string>& get_fft_band_labels()
+{
+    static const std::vector<std::string> labels = {
+        "16 Hz", "20 Hz", "25 Hz", "31.5 Hz", "40 Hz", "50 Hz", "63 Hz", "80 Hz", "100 Hz",
+        "125 Hz", "160 Hz", "200 Hz", "250 Hz", "315 Hz", "400 Hz", "500 Hz", "630 Hz", "800 Hz", "1000 Hz", "1250 Hz",
+        "1600 Hz", "2000 Hz", "2500 Hz", "3150 Hz", "4000 Hz", "5000 Hz", "6300 Hz", "8000 Hz", "10000 Hz", "12500 Hz",
+        "16000 Hz", "20000 Hz"
+    };
+    return labels;
+}
+
 inline JsonEncoder<std::vector<float>> get_fft_bands_encoder()
 {
     return [](const std::string& signal, const std::vector<float>& values) -> std::string {
-        std::vector<std::string> labels = {
-            "16 Hz", "20 Hz", "25 Hz", "31.5 Hz", "40 Hz", "50 Hz", "63 Hz", "80 Hz", "100 Hz",
-            "125 Hz", "160 Hz", "200 Hz", "250 Hz", "315 Hz", "400 Hz", "500 Hz", "630 Hz", "800 Hz", "1000 Hz", "1250 Hz",
-            "1600 Hz", "2000 Hz", "2500 Hz", "3150 Hz", "4000 Hz", "5000 Hz", "6300 Hz", "8000 Hz", "10000 Hz", "12500 Hz",
-            "16000 Hz", "20000 Hz"
-        };
-        json j = encode_labels_with_values(labels, values);
+        json j = encode_labels_with_values(get_fft_band_labels(), values);
         return encode_signal_name_and_json(signal, j);
     };
 }
 
+// Sent once when a session subscribes, so binary band frames only carry the values.
+inline json get_fft_bands_layout()
+{
+    json j;
+    j["labels"] = get_fft_band_labels();
+    return j;
+}
+
+inline std::string encode_signal_layout(const std::string& signal, const json& layout)
+{
+    json j;
+    j["type"] = MessageTypeHelper::type_to_string_.at(MessageTypeHelper::MessageType::Signal_Layout_Message);
+    j["signal"] = signal;
+    j["value"] = layout;
+    return j.dump();
+}
+
+enum class BandValueFormat : uint8_t
+{
+    UInt8 = 0,      // Quantized 0–1.0, for normalized band levels
+    Float32 = 1,
+};
+
+inline BinaryEncoder<std::vector<float>> get_band_vector_encoder(BandValueFormat format = BandValueFormat::UInt8)
+{
+    return [format](const std::string& signal, const std::vector<float>& values, std::vector<uint8_t>& buffer) {
+        const size_t valueSize = format == BandValueFormat::Float32 ? 4 : 1;
+        BinaryWriter writer(buffer, BinaryWriter::headerSize(signal) + 8 + 1 + 2 + values.size() * valueSize);
+
+        writer.header(BinaryEncoderType::Band_Vector_Encoder, signal);
+        writer.u64(binary_timestamp_ms());
+        writer.u8(static_cast<uint8_t>(format));
+        writer.u16(static_cast<uint16_t>(values.size()));
+        for (float value : values)
+        {
+            if (format == BandValueFormat::Float32)
+            {
+                writer.f32(value);
+            }
+            else
+            {
+                writer.u8(static_cast<uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f)));
+            }
+        }
+    };
+}
+
 inline JsonEncoder<BinData> get_bin_data_encoder()
 {
     return [](const std::string& signal, const BinData& data) -> std::string {
@@ -115,6 +170,70 @@ inline JsonEncoder<BinData> get_bin_data_encoder()
     };
 }
 
+inline BinaryEncoder<SpectrumColumn> get_spectrum_column_encoder()
+{
+    return [](const std::string& signal, const SpectrumColumn& column, std::vector<uint8_t>& buffer) {
+        const size_t valueSize = column.format == SpectrumValueFormat::Float16 ? 2 : 1;
+        BinaryWriter writer(buffer, BinaryWriter::headerSize(signal) + 8 + 4 + 4 + 1 + 2 + column.values.size() * valueSize);
+
+        writer.header(BinaryEncoderType::Spectrum_Column_Encoder, signal);
+        writer.u64(binary_timestamp_ms());
+        writer.f32(column.minFrequency);
+        writer.f32(column.maxFrequency);
+        writer.u8(static_cast<uint8_t>(column.format));
+        writer.u16(static_cast<uint16_t>(column.values.size()));
+
+        for (float value : column.values)
+        {
+            const float clamped = std::clamp(value, 0.0f, 1.0f);
+            if (column.format == SpectrumValueFormat::Float16)
+            {
+                writer.u16(float_to_half(clamped));
+            }
+            else
+            {
+                writer.u8(static_cast<uint8_t>(std::lround(clamped * 255.0f)));
+            }
+        }
+    };
+}
+
+inline BinaryEncoder<std::vector<float>> get_timestamped_float_vector_encoder()
+{
+    return [](const std::string& signal, const std::vector<float>& values, std::vector<uint8_t>& buffer) {
+        BinaryWriter writer(buffer, BinaryWriter::headerSize(signal) + 8 + 2 + values.size() * 4);
+
+        writer.header(BinaryEncoderType::Timestamped_Float_Vector_Encoder, signal);
+        writer.u64(binary_timestamp_ms());
+        writer.u16(static_cast<uint16_t>(values.size()));
+        for (float value : values)
+        {
+            writer.f32(value);
+        }
+    };
+}
+
+inline BinaryEncoder<StereoField> get_stereo_field_encoder()
+{
+    return [](const std::string& signal, const StereoField& field, std::vector<uint8_t>& buffer) {
+        BinaryWriter writer(buffer, BinaryWriter::headerSize(signal) + 8 + 4 + 4 + 2 + field.points.size() * 4);
+        auto write_coordinate = [&writer](float v) {
+            writer.i16(static_cast<int16_t>(std::lround(std::clamp(v, -1.0f, 1.0f) * 32767.0f)));
+        };
+
+        writer.header(BinaryEncoderType::Stereo_Field_Encoder, signal);
+        writer.u64(binary_timestamp_ms());
+        writer.f32(field.correlation);
+        writer.f32(field.balance);
+        writer.u16(static_cast<uint16_t>(field.points.size()));
+        for (const Point& point : field.points)
+        {
+            write_coordinate(point.x);
+            write_coordinate(point.y);
+        }
+    };
+}
+
 struct Color
 {
     uint8_t r;
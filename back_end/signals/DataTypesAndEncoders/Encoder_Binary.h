@@ -1,5 +1,13 @@
 #pragma once
 
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+#include <functional>
+
 enum class BinaryEncoderType : uint8_t
 {
     /**
@@ -41,7 +49,316 @@ enum class BinaryEncoderType : uint8_t
      * - All integers are big-endian.
      */
     Timestamped_Int_Vector_Encoder = 2,
+
+    /**
+     * Spectrum_Column_Encoder (0x03)
+     *
+     * Binary layout:
+     * ---------------------------------------------------------------
+     * | Offset | Field         | Size          | Description         |
+     * |--------|---------------|---------------|---------------------|
+     * | 0      | message_type  | 1 byte        | Always 0x03         |
+     * | 1–2    | name_length   | 2 bytes       | Big-endian uint16_t |
+     * | 3–N    | signal_name   | N bytes       | UTF-8               |
+     * | N+1+   | timestamp     | 8 bytes       | Big-endian uint64_t |
+     * | N+9+   | min_frequency | 4 bytes       | Big-endian float32  |
+     * | N+13+  | max_frequency | 4 bytes       | Big-endian float32  |
+     * | N+17   | value_format  | 1 byte        | 0 = uint8, 1 = float16 |
+     * | N+18+  | bin_count     | 2 bytes       | Big-endian uint16_t |
+     * | N+20+  | bins          | count or 2 * count bytes | Magnitudes |
+     *
+     * Notes:
+     * - Timestamp is in milliseconds since epoch.
+     * - Bins are log spaced from min_frequency to max_frequency, lowest first.
+     * - uint8 bins are 0–255 for 0–1.0, float16 bins are big-endian IEEE 754 half floats in 0–1.0.
+     */
+    Spectrum_Column_Encoder = 3,
+
+    /**
+     * Timestamped_Float_Vector_Encoder (0x04)
+     *
+     * Binary layout:
+     * ------------------------------------------------------------
+     * | Offset | Field        | Size         | Description        |
+     * |--------|--------------|--------------|--------------------|
+     * | 0      | message_type | 1 byte       | Always 0x04        |
+     * | 1–2    | name_length  | 2 bytes      | Big-endian uint16_t|
+     * | 3–N    | signal_name  | N bytes      | UTF-8              |
+     * | N+1+   | timestamp    | 8 bytes      | Big-endian uint64_t|
+     * | N+9+   | vector_len   | 2 bytes      | Big-endian uint16_t|
+     * | N+11+  | vector_data  | 4 * len bytes| Big-endian float32 |
+     *
+     * Notes:
+     * - Timestamp is in milliseconds since epoch.
+     */
+    Timestamped_Float_Vector_Encoder = 4,
+
+    /**
+     * Stereo_Field_Encoder (0x05)
+     *
+     * Binary layout:
+     * ---------------------------------------------------------------
+     * | Offset | Field         | Size          | Description         |
+     * |--------|---------------|---------------|---------------------|
+     * | 0      | message_type  | 1 byte        | Always 0x05         |
+     * | 1–2    | name_length   | 2 bytes       | Big-endian uint16_t |
+     * | 3–N    | signal_name   | N bytes       | UTF-8               |
+     * | N+1+   | timestamp     | 8 bytes       | Big-endian uint64_t |
+     * | N+9+   | correlation   | 4 bytes       | Big-endian float32  |
+     * | N+13+  | balance       | 4 bytes       | Big-endian float32  |
+     * | N+17+  | point_count   | 2 bytes       | Big-endian uint16_t |
+     * | N+19+  | points        | 4 * count bytes | int16 side, int16 mid |
+     *
+     * Notes:
+     * - Timestamp is in milliseconds since epoch.
+     * - Point coordinates are big-endian int16_t, -32767–32767 for -1.0–1.0.
+     */
+    Stereo_Field_Encoder = 5,
+
+    /**
+     * Band_Vector_Encoder (0x06)
+     *
+     * Binary layout:
+     * ---------------------------------------------------------------
+     * | Offset | Field         | Size          | Description         |
+     * |--------|---------------|---------------|---------------------|
+     * | 0      | message_type  | 1 byte        | Always 0x06         |
+     * | 1–2    | name_length   | 2 bytes       | Big-endian uint16_t |
+     * | 3–N    | signal_name   | N bytes       | UTF-8               |
+     * | N+1+   | timestamp     | 8 bytes       | Big-endian uint64_t |
+     * | N+9    | value_format  | 1 byte        | 0 = uint8, 1 = float32 |
+     * | N+10+  | band_count    | 2 bytes       | Big-endian uint16_t |
+     * | N+12+  | bands         | count or 4 * count bytes | Band levels |
+     *
+     * Notes:
+     * - Timestamp is in milliseconds since epoch.
+     * - uint8 bands are 0–255 for 0–1.0, float32 bands are big-endian and unclamped.
+     * - Band labels are not repeated per frame, they arrive once per subscription in a
+     *   "signal layout message" sent before the first value.
+     */
+    Band_Vector_Encoder = 6,
+
+    /**
+     * Signal_History_Encoder (0x07)
+     *
+     * Binary layout:
+     * ---------------------------------------------------------------
+     * | Offset | Field         | Size          | Description         |
+     * |--------|---------------|---------------|---------------------|
+     * | 0      | message_type  | 1 byte        | Always 0x07         |
+     * | 1–2    | name_length   | 2 bytes       | Big-endian uint16_t |
+     * | 3–N    | signal_name   | N bytes       | UTF-8               |
+     * | N+1+   | entry_count   | 4 bytes       | Big-endian uint32_t |
+     * | N+5+   | entries       | varies        | entry_count entries |
+     *
+     * Entry layout:
+     * | 0      | timestamp     | 8 bytes       | Big-endian uint64_t |
+     * | 8      | entry_format  | 1 byte        | 0 = text, 1 = binary |
+     * | 9–12   | entry_length  | 4 bytes       | Big-endian uint32_t |
+     * | 13+    | entry_message | length bytes  | Encoded value       |
+     *
+     * Notes:
+     * - Timestamp is in milliseconds since epoch, when the value was published.
+     * - Each entry is the complete message the signal's own encoder produces for that value,
+     *   a JSON text message or a binary message starting with its own message_type.
+     * - Entries are oldest first.
+     */
+    Signal_History_Encoder = 7,
+
+    /**
+     * Signal_Batch_Encoder (0x08)
+     *
+     * Binary layout:
+     * ---------------------------------------------------------------
+     * | Offset | Field         | Size          | Description         |
+     * |--------|---------------|---------------|---------------------|
+     * | 0      | message_type  | 1 byte        | Always 0x08         |
+     * | 1–2    | name_length   | 2 bytes       | Always 0            |
+     * | 3–6    | entry_count   | 4 bytes       | Big-endian uint32_t |
+     * | 7+     | entries       | varies        | entry_count entries |
+     *
+     * Entry layout:
+     * | 0      | entry_format  | 1 byte        | 0 = text, 1 = binary |
+     * | 1–4    | entry_length  | 4 bytes       | Big-endian uint32_t |
+     * | 5+     | entry_message | length bytes  | Encoded value       |
+     *
+     * Notes:
+     * - Carries the values of several signals committed together in one SignalBatch, so a client
+     *   applies them in the same frame. Only the signals the session subscribes to are included.
+     * - Each entry is the complete message the signal's own encoder produces, as for the history.
+     */
+    Signal_Batch_Encoder = 8,
 };
 
+// Writes the encoded value into buffer, which arrives empty but may have pooled capacity.
+// Leaving it empty means there is nothing to send.
+template<typename T>
+using BinaryEncoder = std::function<void(const std::string&, const T&, std::vector<uint8_t>&)>;
+
+// Reads a message written by the matching encoder back into a value. Returns false if the message is malformed.
 template<typename T>
-using BinaryEncoder = std::function<std::vector<uint8_t>(const std::string&, const T&)>;
+using BinaryDecoder = std::function<bool(const uint8_t*, size_t, T&)>;
+
+inline uint64_t binary_timestamp_ms()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+// Sizes the buffer once for the whole message and writes big-endian fields through a raw pointer.
+class BinaryWriter
+{
+    public:
+        BinaryWriter(std::vector<uint8_t>& buffer, size_t size)
+        {
+            buffer.resize(size);
+            out_ = buffer.data();
+            end_ = out_ + size;
+        }
+
+        // Size of the type, name length and name fields every encoder starts with.
+        static size_t headerSize(const std::string& name)
+        {
+            return 1 + 2 + name.size();
+        }
+
+        void header(BinaryEncoderType type, const std::string& name)
+        {
+            u8(static_cast<uint8_t>(type));
+            u16(static_cast<uint16_t>(name.size()));
+            bytes(name.data(), name.size());
+        }
+
+        void u8(uint8_t v)
+        {
+            assert(out_ + 1 <= end_);
+            *out_++ = v;
+        }
+
+        void u16(uint16_t v)
+        {
+            assert(out_ + 2 <= end_);
+            out_[0] = static_cast<uint8_t>(v >> 8);
+            out_[1] = static_cast<uint8_t>(v);
+            out_ += 2;
+        }
+
+        void u32(uint32_t v)
+        {
+            assert(out_ + 4 <= end_);
+            out_[0] = static_cast<uint8_t>(v >> 24);
+            out_[1] = static_cast<uint8_t>(v >> 16);
+            out_[2] = static_cast<uint8_t>(v >> 8);
+            out_[3] = static_cast<uint8_t>(v);
+            out_ += 4;
+        }
+
+        void u64(uint64_t v)
+        {
+            u32(static_cast<uint32_t>(v >> 32));
+            u32(static_cast<uint32_t>(v));
+        }
+
+        void i16(int16_t v) { u16(static_cast<uint16_t>(v)); }
+        void i32(int32_t v) { u32(static_cast<uint32_t>(v)); }
+
+        void f32(float v)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &v, sizeof(bits));
+            u32(bits);
+        }
+
+        void bytes(const void* data, size_t size)
+        {
+            assert(out_ + size <= end_);
+            std::memcpy(out_, data, size);
+            out_ += size;
+        }
+
+        size_t remaining() const { return static_cast<size_t>(end_ - out_); }
+
+    private:
+        uint8_t* out_;
+        uint8_t* end_;
+};
+
+// Reads big-endian fields in the order BinaryWriter wrote them. Reading past the end leaves ok() false
+// and yields zeros, so a decoder checks ok() once at the end instead of after every field.
+class BinaryReader
+{
+    public:
+        BinaryReader(const uint8_t* data, size_t size)
+            : in_(data)
+            , end_(data + size)
+        {
+        }
+
+        // Skips the type, name length and name fields, checking the type.
+        void header(BinaryEncoderType type)
+        {
+            if (u8() != static_cast<uint8_t>(type))
+            {
+                ok_ = false;
+            }
+            skip(u16());
+        }
+
+        uint8_t u8()
+        {
+            return take(1) ? in_[-1] : 0;
+        }
+
+        uint16_t u16()
+        {
+            if (!take(2))
+                return 0;
+            return static_cast<uint16_t>((in_[-2] << 8) | in_[-1]);
+        }
+
+        uint32_t u32()
+        {
+            if (!take(4))
+                return 0;
+            return (static_cast<uint32_t>(in_[-4]) << 24) | (static_cast<uint32_t>(in_[-3]) << 16)
+                 | (static_cast<uint32_t>(in_[-2]) << 8) | static_cast<uint32_t>(in_[-1]);
+        }
+
+        uint64_t u64()
+        {
+            const uint64_t high = u32();
+            return (high << 32) | u32();
+        }
+
+        int16_t i16() { return static_cast<int16_t>(u16()); }
+        int32_t i32() { return static_cast<int32_t>(u32()); }
+
+        float f32()
+        {
+            const uint32_t bits = u32();
+            float v;
+            std::memcpy(&v, &bits, sizeof(v));
+            return v;
+        }
+
+        void skip(size_t size) { take(size); }
+
+        size_t remaining() const { return static_cast<size_t>(end_ - in_); }
+        bool ok() const { return ok_; }
+
+    private:
+        bool take(size_t size)
+        {
+            if (!ok_ || remaining() < size)
+            {
+                ok_ = false;
+                return false;
+            }
+            in_ += size;
+            return true;
+        }
+
+        const uint8_t* in_;
+        const uint8_t* end_;
+        bool ok_ = true;
+};
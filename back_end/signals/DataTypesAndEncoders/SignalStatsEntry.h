@@ -0,0 +1,120 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <ostream>
+#include <nlohmann/json.hpp>
+using json = nlohmann::json;
+
+// Cost of one registered callback, the subscriber is named by dispatch, executor and arg.
+struct SubscriberStats
+{
+    std::string subscriber;
+    uint64_t calls = 0;
+    uint64_t totalNs = 0;
+    uint64_t maxNs = 0;
+
+    bool operator==(const SubscriberStats& other) const
+    {
+        return subscriber == other.subscriber && calls == other.calls && totalNs == other.totalNs && maxNs == other.maxNs;
+    }
+
+    bool operator!=(const SubscriberStats& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+// Counters of one signal since start. The rates are filled in by SignalStatsMonitor from two samples.
+struct SignalStatsEntry
+{
+    std::string name;
+    uint64_t sets = 0;                  // setValue calls
+    uint64_t publishes = 0;             // setValue calls that published a new value
+    uint64_t compareNs = 0;             // Change detection and snapshot, over all setValue calls
+    uint64_t encodes = 0;
+    uint64_t encodeNs = 0;
+    uint64_t encodedBytes = 0;
+    uint64_t webSocketSends = 0;
+    uint64_t webSocketConflated = 0;    // Changes folded into a later send by the rate limit
+    std::vector<SubscriberStats> subscribers;
+    double publishRateHz = 0.0;
+    double encodedBytesPerSecond = 0.0;
+
+    bool operator==(const SignalStatsEntry& other) const
+    {
+        return name == other.name && sets == other.sets && publishes == other.publishes && compareNs == other.compareNs &&
+            encodes == other.encodes && encodeNs == other.encodeNs && encodedBytes == other.encodedBytes &&
+            webSocketSends == other.webSocketSends && webSocketConflated == other.webSocketConflated &&
+            subscribers == other.subscribers && publishRateHz == other.publishRateHz &&
+            encodedBytesPerSecond == other.encodedBytesPerSecond;
+    }
+
+    bool operator!=(const SignalStatsEntry& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+inline void to_json(json& j, const SubscriberStats& stats)
+{
+    j = json{
+        {"subscriber", stats.subscriber},
+        {"calls", stats.calls},
+        {"totalNs", stats.totalNs},
+        {"maxNs", stats.maxNs}
+    };
+}
+
+inline void from_json(const json& j, SubscriberStats& stats)
+{
+    j.at("subscriber").get_to(stats.subscriber);
+    j.at("calls").get_to(stats.calls);
+    j.at("totalNs").get_to(stats.totalNs);
+    j.at("maxNs").get_to(stats.maxNs);
+}
+
+inline void to_json(json& j, const SignalStatsEntry& stats)
+{
+    j = json{
+        {"name", stats.name},
+        {"sets", stats.sets},
+        {"publishes", stats.publishes},
+        {"compareNs", stats.compareNs},
+        {"encodes", stats.encodes},
+        {"encodeNs", stats.encodeNs},
+        {"encodedBytes", stats.encodedBytes},
+        {"webSocketSends", stats.webSocketSends},
+        {"webSocketConflated", stats.webSocketConflated},
+        {"subscribers", stats.subscribers},
+        {"publishRateHz", stats.publishRateHz},
+        {"encodedBytesPerSecond", stats.encodedBytesPerSecond}
+    };
+}
+
+inline void from_json(const json& j, SignalStatsEntry& stats)
+{
+    j.at("name").get_to(stats.name);
+    j.at("sets").get_to(stats.sets);
+    j.at("publishes").get_to(stats.publishes);
+    j.at("compareNs").get_to(stats.compareNs);
+    j.at("encodes").get_to(stats.encodes);
+    j.at("encodeNs").get_to(stats.encodeNs);
+    j.at("encodedBytes").get_to(stats.encodedBytes);
+    j.at("webSocketSends").get_to(stats.webSocketSends);
+    j.at("webSocketConflated").get_to(stats.webSocketConflated);
+    j.at("subscribers").get_to(stats.subscribers);
+    j.at("publishRateHz").get_to(stats.publishRateHz);
+    j.at("encodedBytesPerSecond").get_to(stats.encodedBytesPerSecond);
+}
+
+inline std::ostream& operator<<(std::ostream& os, const SignalStatsEntry& stats)
+{
+    os << "SignalStatsEntry{name=" << stats.name
+       << ", publishes=" << stats.publishes
+       << ", publishRateHz=" << stats.publishRateHz
+       << ", subscribers=" << stats.subscribers.size()
+       << "}";
+    return os;
+}
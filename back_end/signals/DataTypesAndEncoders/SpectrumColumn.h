@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <istream>
+#include <stdexcept>
+#include <nlohmann/json.hpp>
+using json = nlohmann::json;
+
+enum class SpectrumValueFormat : uint8_t
+{
+    UInt8 = 0,
+    Float16 = 1,
+};
+
+inline std::string to_string(SpectrumValueFormat format)
+{
+    switch (format)
+    {
+        case SpectrumValueFormat::UInt8:   return "UInt8";
+        case SpectrumValueFormat::Float16: return "Float16";
+        default: throw std::invalid_argument("Unknown SpectrumValueFormat");
+    }
+}
+
+inline std::ostream& operator<<(std::ostream& os, SpectrumValueFormat format)
+{
+    switch (format)
+    {
+        case SpectrumValueFormat::UInt8:   os << "UInt8";   break;
+        case SpectrumValueFormat::Float16: os << "Float16"; break;
+        default:                           os.setstate(std::ios::failbit); break;
+    }
+    return os;
+}
+
+inline std::istream& operator>>(std::istream& is, SpectrumValueFormat& format)
+{
+    std::string token;
+    is >> token;
+
+    if (token == "UInt8")        format = SpectrumValueFormat::UInt8;
+    else if (token == "Float16") format = SpectrumValueFormat::Float16;
+    else                         is.setstate(std::ios::failbit);
+
+    return is;
+}
+
+// IEEE 754 binary16, round to nearest. Spectrum values are normalized to 0–1.0 so subnormals are flushed to zero.
+inline uint16_t float_to_half(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    const int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xFF) - 127 + 15;
+    const uint32_t mantissa = bits & 0x7FFFFF;
+
+    if (((bits >> 23) & 0xFF) == 0xFF) return sign | 0x7C00 | (mantissa ? 0x200 : 0); // Inf / NaN
+    if (exponent <= 0) return sign;
+    if (exponent >= 31) return sign | 0x7C00;
+
+    uint16_t half = sign | static_cast<uint16_t>(exponent << 10) | static_cast<uint16_t>(mantissa >> 13);
+    if ((mantissa & 0x1FFF) > 0x1000 || ((mantissa & 0x1FFF) == 0x1000 && (half & 1)))
+    {
+        ++half;
+    }
+    return half;
+}
+
+// One column of a log binned magnitude spectrum, values normalized to 0–1.0 with Min db / Max db.
+struct SpectrumColumn
+{
+    float minFrequency = 0.0f;
+    float maxFrequency = 0.0f;
+    SpectrumValueFormat format = SpectrumValueFormat::UInt8;
+    std::vector<float> values;
+
+    bool operator==(const SpectrumColumn& other) const
+    {
+        return minFrequency == other.minFrequency &&
+            maxFrequency == other.maxFrequency &&
+            format == other.format &&
+            values == other.values;
+    }
+
+    bool operator!=(const SpectrumColumn& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+inline void to_json(json& j, const SpectrumColumn& column)
+{
+    j = json{
+        {"minFrequency", column.minFrequency},
+        {"maxFrequency", column.maxFrequency},
+        {"format", to_string(column.format)},
+        {"values", column.values}
+    };
+}
+
+inline void from_json(const json& j, SpectrumColumn& column)
+{
+    j.at("minFrequency").get_to(column.minFrequency);
+    j.at("maxFrequency").get_to(column.maxFrequency);
+    column.format = j.at("format").get<std::string>() == "Float16" ? SpectrumValueFormat::Float16 : SpectrumValueFormat::UInt8;
+    j.at("values").get_to(column.values);
+}
+
+inline std::ostream& operator<<(std::ostream& os, const SpectrumColumn& column)
+{
+    os << "SpectrumColumn{minFrequency=" << column.minFrequency
+       << ", maxFrequency=" << column.maxFrequency
+       << ", format=" << column.format
+       << ", bins=" << column.values.size()
+       << "}";
+    return os;
+}
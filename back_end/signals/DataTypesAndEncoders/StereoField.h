@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+#include <ostream>
+#include <algorithm>
+#include <nlohmann/json.hpp>
+#include "Point.h"
+using json = nlohmann::json;
+
+// Stereo image of one capture block. Points are (side, mid) pairs scaled to -1.0–1.0 by the block's peak.
+struct StereoField
+{
+    float correlation = 0.0f;   // -1.0 out of phase, 0 unrelated, 1.0 mono
+    float balance = 0.0f;       // -1.0 full left, 1.0 full right
+    std::vector<Point> points;
+
+    bool operator==(const StereoField& other) const
+    {
+        return correlation == other.correlation &&
+            balance == other.balance &&
+            std::equal(points.begin(), points.end(), other.points.begin(), other.points.end(),
+                [](const Point& a, const Point& b) { return a.x == b.x && a.y == b.y; });
+    }
+
+    bool operator!=(const StereoField& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+inline void to_json(json& j, const StereoField& field)
+{
+    json points = json::array();
+    for (const Point& point : field.points)
+    {
+        points.push_back({point.x, point.y});
+    }
+    j = json{
+        {"correlation", field.correlation},
+        {"balance", field.balance},
+        {"points", points}
+    };
+}
+
+inline void from_json(const json& j, StereoField& field)
+{
+    j.at("correlation").get_to(field.correlation);
+    j.at("balance").get_to(field.balance);
+    field.points.clear();
+    for (const json& point : j.at("points"))
+    {
+        field.points.push_back({point.at(0).get<float>(), point.at(1).get<float>()});
+    }
+}
+
+inline std::ostream& operator<<(std::ostream& os, const StereoField& field)
+{
+    os << "StereoField{correlation=" << field.correlation
+       << ", balance=" << field.balance
+       << ", points=" << field.points.size()
+       << "}";
+    return os;
+}
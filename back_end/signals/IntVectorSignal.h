@@ -18,52 +18,50 @@ public:
                    , std::shared_ptr<WebSocketServer> webSocketServer)                        
                    : Signal<std::vector<int32_t>>(signalName, webSocketServer, get_timestamped_int32_vector_to_binary_encoder())
     {
-        SignalManager::getInstance().createSignal(signalName, webSocketServer, get_timestamped_int32_vector_to_binary_encoder());
+        // Every capture buffer is new audio, comparing 1024 samples per publish would never skip one.
+        setChangeDetection(ChangeDetection::AlwaysPublish);
+        auto signal = SignalManager::getInstance().createSignal(signalName, webSocketServer, get_timestamped_int32_vector_to_binary_encoder());
+        signal->setChangeDetection(ChangeDetection::AlwaysPublish);
+        // Lets SignalReplay feed recorded capture buffers back in, driving the whole pipeline offline.
+        signal->setBinaryDecoder(get_timestamped_int32_vector_binary_decoder());
     }
 
 private:
 
     BinaryEncoder<std::vector<int32_t>> get_timestamped_int32_vector_to_binary_encoder() const
     {
-        return [this](const std::string& name, const std::vector<int32_t>& vec) -> std::vector<uint8_t>
+        return [](const std::string& name, const std::vector<int32_t>& vec, std::vector<uint8_t>& buffer)
         {
-            std::vector<uint8_t> buffer;
-
-            // Message type
-            buffer.push_back(static_cast<uint8_t>(BinaryEncoderType::Timestamped_Int_Vector_Encoder));
-
-            // Name length (2 bytes, big-endian)
-            uint16_t name_len = static_cast<uint16_t>(name.size());
-            buffer.push_back((name_len >> 8) & 0xFF);
-            buffer.push_back(name_len & 0xFF);
-
-            // Signal name
-            buffer.insert(buffer.end(), name.begin(), name.end());
-
-            // Timestamp (8 bytes, big-endian)
-            uint64_t timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
-                std::chrono::system_clock::now().time_since_epoch()).count());
-
-            for (int i = 7; i >= 0; --i)
+            // Type, name, timestamp (8 bytes), count (2 bytes) and 4 bytes per sample, all big-endian
+            BinaryWriter writer(buffer, BinaryWriter::headerSize(name) + 8 + 2 + vec.size() * 4);
+            writer.header(BinaryEncoderType::Timestamped_Int_Vector_Encoder, name);
+            writer.u64(binary_timestamp_ms());
+            writer.u16(static_cast<uint16_t>(vec.size()));
+            for (int32_t val : vec)
             {
-                buffer.push_back((timestamp >> (i * 8)) & 0xFF);
+                writer.i32(val);
             }
+        };
+    }
 
-            // Vector count (2 bytes, big-endian)
-            uint16_t count = static_cast<uint16_t>(vec.size());
-            buffer.push_back((count >> 8) & 0xFF);
-            buffer.push_back(count & 0xFF);
-
-            // Vector payload (4 bytes per int, big-endian)
-            for (int32_t val : vec)
+    BinaryDecoder<std::vector<int32_t>> get_timestamped_int32_vector_binary_decoder() const
+    {
+        return [](const uint8_t* data, size_t size, std::vector<int32_t>& vec)
+        {
+            BinaryReader reader(data, size);
+            reader.header(BinaryEncoderType::Timestamped_Int_Vector_Encoder);
+            reader.u64();
+            const uint16_t count = reader.u16();
+            if (!reader.ok() || reader.remaining() < count * 4u)
             {
-                buffer.push_back((val >> 24) & 0xFF);
-                buffer.push_back((val >> 16) & 0xFF);
-                buffer.push_back((val >> 8) & 0xFF);
-                buffer.push_back(val & 0xFF);
+                return false;
             }
-
-            return buffer;
+            vec.resize(count);
+            for (int32_t& val : vec)
+            {
+                val = reader.i32();
+            }
+            return reader.ok();
         };
     }
 
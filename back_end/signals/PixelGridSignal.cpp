@@ -15,6 +15,9 @@ PixelGridSignal::PixelGridSignal(const std::string& signalName,
 {
     logger_ = initializeLogger("PixelGridSignal", spdlog::level::info);
     logger_->info("PixelGridSignal created with dimensions: {}x{}", width_, height_);
+    signal_->setChangeDetection(ChangeDetection::ProducerVersion);
+    // Animations render at up to 100 Hz for the LEDs, the browser preview only needs display rate.
+    signal_->setWebSocketMaxRate(WEBSOCKET_DISPLAY_RATE_HZ);
     ledController_->run();
 }
 
@@ -23,9 +26,10 @@ void PixelGridSignal::setPixel(size_t x, size_t y, RGB color)
     std::lock_guard<std::mutex> lock(mutex_);
     
     ledController_->setPixel(y, color.r, color.g, color.b);
-    if (x < width_ && y < height_)
+    if (x < width_ && y < height_ && pixels_[y][x] != color)
     {
         pixels_[y][x] = color;
+        ++version_;
     }
 }
 
@@ -42,16 +46,28 @@ RGB PixelGridSignal::getValue(size_t x, size_t y) const
 void PixelGridSignal::clear(RGB color)
 {
     std::lock_guard<std::mutex> lock(mutex_);
+    bool changed = false;
     for (auto& row : pixels_)
     {
-        std::fill(row.begin(), row.end(), color);
+        for (RGB& pixel : row)
+        {
+            if (pixel != color)
+            {
+                pixel = color;
+                changed = true;
+            }
+        }
+    }
+    if (changed)
+    {
+        ++version_;
     }
 }
 
 void PixelGridSignal::notify()
 {
     std::lock_guard<std::mutex> lock(mutex_);
-    signal_->setValue(pixels_);
+    signal_->setVersionedValue(pixels_, version_);
 }
 
 std::shared_ptr<Signal<std::vector<std::vector<RGB>>>> PixelGridSignal::GetSignal() const
@@ -98,47 +98,27 @@ private:
     std::shared_ptr<Signal<std::vector<std::vector<RGB>>>> signal_;
     std::shared_ptr<spdlog::logger> logger_;
     mutable std::mutex mutex_;
+    // Bumped whenever a pixel actually changes, so notify() never compares the whole grid.
+    uint64_t version_ = 0;
     std::shared_ptr<LED_Controller> ledController_ = std::make_shared<LED_Controller>(144);
 
     BinaryEncoder<std::vector<std::vector<RGB>>> get_rgb_matrix_to_binary_encoder()
     {
-        return [this](const std::string& signal_name, const std::vector<std::vector<RGB>>& matrix) -> std::vector<uint8_t>
+        return [](const std::string& signal_name, const std::vector<std::vector<RGB>>& matrix, std::vector<uint8_t>& buffer)
         {
-            std::vector<uint8_t> buffer;
-
-            buffer.reserve(1 + 2 + signal_name.size() + 2 + 2 + matrix.size() * (matrix.empty() ? 0 : matrix[0].size()) * 3);
-
-            // Type prefix
-            buffer.push_back(static_cast<uint8_t>(BinaryEncoderType::Named_Binary_Encoder));
-
-            // Signal name length (big-endian)
-            uint16_t name_len = static_cast<uint16_t>(signal_name.size());
-            buffer.push_back((name_len >> 8) & 0xFF);
-            buffer.push_back(name_len & 0xFF);
-
-            // Signal name bytes
-            buffer.insert(buffer.end(), signal_name.begin(), signal_name.end());
-
-            // Rows and cols (big-endian)
-            uint16_t rows = static_cast<uint16_t>(matrix.size());
-            uint16_t cols = rows > 0 ? static_cast<uint16_t>(matrix[0].size()) : 0;
-            buffer.push_back((rows >> 8) & 0xFF);
-            buffer.push_back(rows & 0xFF);
-            buffer.push_back((cols >> 8) & 0xFF);
-            buffer.push_back(cols & 0xFF);
-
-            // Pixel data in row-major order
+            // Rows and cols (big-endian), then pixel data in row-major order
+            const uint16_t rows = static_cast<uint16_t>(matrix.size());
+            const uint16_t cols = rows > 0 ? static_cast<uint16_t>(matrix[0].size()) : 0;
+            BinaryWriter writer(buffer, BinaryWriter::headerSize(signal_name) + 2 + 2 + static_cast<size_t>(rows) * cols * 3);
+
+            writer.header(BinaryEncoderType::Named_Binary_Encoder, signal_name);
+            writer.u16(rows);
+            writer.u16(cols);
             for (const auto& row : matrix)
             {
-                for (const RGB& pixel : row)
-                {
-                    buffer.push_back(pixel.r);
-                    buffer.push_back(pixel.g);
-                    buffer.push_back(pixel.b);
-                }
+                static_assert(sizeof(RGB) == 3, "RGB rows are copied as packed r, g, b bytes");
+                writer.bytes(row.data(), std::min<size_t>(row.size(), cols) * sizeof(RGB));
             }
-
-            return buffer;
         };
     }
 
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <deque>
+#include <atomic>
+#include <functional>
+#include <unordered_map>
+#include <condition_variable>
+#include "../logger.h"
+
+// A named worker thread that runs signal callbacks posted by producers, so a slow subscriber never
+// runs on the capture or FFT thread. Tasks run in the order they were posted.
+class SignalExecutor
+{
+    public:
+        static constexpr size_t DEFAULT_MAX_QUEUED_TASKS = 1024;
+
+        // Executors are shared by name and started on first use.
+        static std::shared_ptr<SignalExecutor> get(const std::string& name)
+        {
+            static std::mutex registryMutex;
+            static std::unordered_map<std::string, std::shared_ptr<SignalExecutor>> registry;
+
+            std::lock_guard<std::mutex> lock(registryMutex);
+            auto it = registry.find(name);
+            if (it != registry.end())
+            {
+                return it->second;
+            }
+            auto executor = std::make_shared<SignalExecutor>(name);
+            registry[name] = executor;
+            return executor;
+        }
+
+        explicit SignalExecutor(const std::string& name, size_t maxQueuedTasks = DEFAULT_MAX_QUEUED_TASKS)
+            : name_(name)
+            , maxQueuedTasks_(std::max<size_t>(1, maxQueuedTasks))
+            , logger_(initializeLogger("Signal Executor " + name, spdlog::level::info))
+            , rateLimitedLog_(std::make_shared<RateLimitedLogger>(logger_, std::chrono::seconds(10)))
+        {
+            thread_ = std::thread(&SignalExecutor::run, this);
+            logger_->info("Signal Executor {}: Started.", name_);
+        }
+
+        ~SignalExecutor()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            cv_.notify_all();
+            if (thread_.joinable())
+            {
+                thread_.join();
+            }
+        }
+
+        SignalExecutor(const SignalExecutor&) = delete;
+        SignalExecutor& operator=(const SignalExecutor&) = delete;
+
+        // Never blocks the caller. Returns false and drops the task when the queue is full.
+        bool post(std::function<void()> task)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (tasks_.size() >= maxQueuedTasks_)
+                {
+                    ++droppedTasks_;
+                    rateLimitedLog_->log("dropped", spdlog::level::warn, "Signal Executor {}: Queue full, dropped task.", name_);
+                    return false;
+                }
+                tasks_.push_back(std::move(task));
+            }
+            cv_.notify_one();
+            return true;
+        }
+
+        const std::string& getName() const { return name_; }
+
+        size_t getQueueDepth() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return tasks_.size();
+        }
+
+        uint64_t getDroppedTasks() const { return droppedTasks_.load(); }
+
+    private:
+        void run()
+        {
+            while (true)
+            {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+                    if (stop_ && tasks_.empty())
+                    {
+                        return;
+                    }
+                    task = std::move(tasks_.front());
+                    tasks_.pop_front();
+                }
+
+                try
+                {
+                    task();
+                }
+                catch (const std::exception& e)
+                {
+                    logger_->error("Signal Executor {}: Exception in callback: {}", name_, e.what());
+                }
+                catch (...)
+                {
+                    logger_->error("Signal Executor {}: Unknown exception in callback", name_);
+                }
+            }
+        }
+
+        std::string name_;
+        size_t maxQueuedTasks_;
+        std::shared_ptr<spdlog::logger> logger_;
+        std::shared_ptr<RateLimitedLogger> rateLimitedLog_;
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;
+        std::deque<std::function<void()>> tasks_;
+        std::atomic<uint64_t> droppedTasks_{0};
+        bool stop_ = false;
+        std::thread thread_;
+};
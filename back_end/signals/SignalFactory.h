@@ -2,12 +2,15 @@
 
 #include "signal.h"
 #include "IntVectorSignal.h"
+#include "SignalKeys.h"
 #include "../websocket_server.h"
 #include "DataTypesAndEncoders/DataTypesAndEncoders.h"
 
 class SignalFactory
 {
 public:
+    static constexpr size_t SYSTEM_STATUS_HISTORY_ENTRIES = 300;
+
     static void CreateSignals(std::shared_ptr<WebSocketServer> webSocketServer)
     {
         if (!webSocketServer)
@@ -18,42 +21,59 @@ public:
         SignalManager& signalManager = SignalManager::getInstance();
 
         //Microphone Signals
-        IntVectorSignal("Microphone", webSocketServer);
-        IntVectorSignal("Microphone Left Channel", webSocketServer);
-        IntVectorSignal("Microphone Right Channel", webSocketServer);
+        IntVectorSignal(SignalKeys::Microphone.name, webSocketServer);
+        IntVectorSignal(SignalKeys::MicrophoneLeftChannel.name, webSocketServer);
+        IntVectorSignal(SignalKeys::MicrophoneRightChannel.name, webSocketServer);
 
         //Audio Signals
-        signalManager.createSignal<std::vector<float>>("FFT Bands", webSocketServer, get_fft_bands_encoder());
-        signalManager.createSignal<std::vector<float>>("FFT Bands Left Channel", webSocketServer, get_fft_bands_encoder());
-        signalManager.createSignal<std::vector<float>>("FFT Bands Right Channel", webSocketServer, get_fft_bands_encoder());
+        for (const auto& key : {SignalKeys::FFTBands, SignalKeys::FFTBandsLeftChannel, SignalKeys::FFTBandsRightChannel})
+        {
+            auto bands = signalManager.createSignal(key, webSocketServer, get_band_vector_encoder());
+            bands->setWebSocketLayout(get_fft_bands_layout());
+            bands->setWebSocketMaxRate(WEBSOCKET_DISPLAY_RATE_HZ);
+            bands->enableHistory(WEBSOCKET_DISPLAY_HISTORY_ENTRIES);
+        }
+        signalManager.createSignal(SignalKeys::AnalysisEngine, webSocketServer, get_signal_and_value_encoder<std::string>());
+        signalManager.createSignal(SignalKeys::FFTQueueOverflowPolicy, webSocketServer, get_signal_and_value_encoder<std::string>());
+        signalManager.createSignal(SignalKeys::FFTBatchPublishMode, webSocketServer, get_signal_and_value_encoder<std::string>());
+        signalManager.createSignal(SignalKeys::FFTSize, webSocketServer, get_signal_and_value_encoder<uint32_t>());
+        signalManager.createSignal(SignalKeys::FFTHop, webSocketServer, get_signal_and_value_encoder<uint32_t>());
+        signalManager.createSignal(SignalKeys::SpectrumColumnRate, webSocketServer, get_signal_and_value_encoder<float>());
+        signalManager.createSignal(SignalKeys::SpectrumFormat, webSocketServer, get_signal_and_value_encoder<std::string>());
+        signalManager.createSignal(SignalKeys::HarmonicPitchDetection, webSocketServer, get_signal_and_value_encoder<bool>());
+
+        //Loudness Signals
+        signalManager.createSignal(SignalKeys::LoudnessWeighting, webSocketServer, get_signal_and_value_encoder<std::string>());
+
+        //Stereo Signals
+        signalManager.createSignal(SignalKeys::StereoPointBudget, webSocketServer, get_signal_and_value_encoder<uint32_t>());
 
         //System Signals
-        signalManager.createSignal<std::string>("CPU Usage", webSocketServer, get_signal_and_value_encoder<std::string>());
-        signalManager.createSignal<std::string>("CPU Memory Usage", webSocketServer, get_signal_and_value_encoder<std::string>());
-        signalManager.createSignal<std::string>("CPU Temp", webSocketServer, get_signal_and_value_encoder<std::string>());
-        signalManager.createSignal<std::string>("GPU Temp", webSocketServer, get_signal_and_value_encoder<std::string>());
-        signalManager.createSignal<std::string>("Throttle Status", webSocketServer, get_signal_and_value_encoder<std::string>());
-        signalManager.createSignal<std::string>("Net RX", webSocketServer, get_signal_and_value_encoder<std::string>());
-        signalManager.createSignal<std::string>("Net TX", webSocketServer, get_signal_and_value_encoder<std::string>());
-        signalManager.createSignal<std::string>("Disk Usage", webSocketServer, get_signal_and_value_encoder<std::string>());
-        signalManager.createSignal<std::string>("Load Avg", webSocketServer, get_signal_and_value_encoder<std::string>());
-        signalManager.createSignal<std::string>("Uptime", webSocketServer, get_signal_and_value_encoder<std::string>());
+        // Status updates once a second, so this is the last five minutes.
+        for (const auto& key : { SignalKeys::CPUUsage, SignalKeys::CPUMemoryUsage, SignalKeys::CPUTemp, SignalKeys::GPUTemp
+                               , SignalKeys::ThrottleStatus, SignalKeys::NetRX, SignalKeys::NetTX, SignalKeys::DiskUsage
+                               , SignalKeys::LoadAvg, SignalKeys::Uptime })
+        {
+            signalManager.createSignal(key, webSocketServer, get_signal_and_value_encoder<std::string>())->enableHistory(SYSTEM_STATUS_HISTORY_ENTRIES);
+        }
+        signalManager.createSignal(SignalKeys::SignalStats, webSocketServer, get_signal_and_value_encoder<std::vector<SignalStatsEntry>>());
 
         //Rendering Signals        
-        signalManager.createSignal<std::string>("Color Mapping Type", webSocketServer, get_signal_and_value_encoder<std::string>())->setValue(to_string(ColorMappingType::Linear));
+        signalManager.createSignal(SignalKeys::ColorMappingType, webSocketServer, get_signal_and_value_encoder<std::string>())->setValue(to_string(ColorMappingType::Linear));
 
         //Sensitivity and Threshold Signals
-        signalManager.createSignal<float>("Min db", webSocketServer, get_signal_and_value_encoder<float>());
-        signalManager.createSignal<float>("Max db", webSocketServer, get_signal_and_value_encoder<float>());
+        signalManager.createSignal(SignalKeys::MinDb, webSocketServer, get_signal_and_value_encoder<float>());
+        signalManager.createSignal(SignalKeys::MaxDb, webSocketServer, get_signal_and_value_encoder<float>());
+        signalManager.createSignal(SignalKeys::DbRangeMode, webSocketServer, get_signal_and_value_encoder<std::string>());
 
         //Brightness and Current Signals
-        signalManager.createSignal<float>("Calculated Current", webSocketServer, get_signal_and_value_encoder<float>());
-        signalManager.createSignal<uint32_t>("Current Limit", webSocketServer, get_signal_and_value_encoder<uint32_t>());
-        signalManager.createSignal<float>("Brightness", webSocketServer, get_signal_and_value_encoder<float>());
-        signalManager.createSignal<uint8_t>("LED Driver Limit", webSocketServer, get_signal_and_value_encoder<std::uint8_t>());
+        signalManager.createSignal(SignalKeys::CalculatedCurrent, webSocketServer, get_signal_and_value_encoder<float>());
+        signalManager.createSignal(SignalKeys::CurrentLimit, webSocketServer, get_signal_and_value_encoder<uint32_t>());
+        signalManager.createSignal(SignalKeys::Brightness, webSocketServer, get_signal_and_value_encoder<float>());
+        signalManager.createSignal(SignalKeys::LEDDriverLimit, webSocketServer, get_signal_and_value_encoder<std::uint8_t>());
 
         //Render Frequency Signals
-        signalManager.createSignal<float>("Minimum Render Frequency", webSocketServer, get_signal_and_value_encoder<float>());
-        signalManager.createSignal<float>("Maximum Render Frequency", webSocketServer, get_signal_and_value_encoder<float>());
+        signalManager.createSignal(SignalKeys::MinimumRenderFrequency, webSocketServer, get_signal_and_value_encoder<float>());
+        signalManager.createSignal(SignalKeys::MaximumRenderFrequency, webSocketServer, get_signal_and_value_encoder<float>());
     }
 };
\ No newline at end of file
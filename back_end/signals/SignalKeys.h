@@ -0,0 +1,69 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "signal.h"
+#include "DataTypesAndEncoders/DataTypesAndEncoders.h"
+
+// Every signal with a fixed name. SignalFactory creates them and consumers resolve them from here,
+// so both sides always agree on the name and the value type.
+namespace SignalKeys
+{
+    //Microphone Signals
+    inline const SignalKey<std::vector<int32_t>> Microphone{"Microphone"};
+    inline const SignalKey<std::vector<int32_t>> MicrophoneLeftChannel{"Microphone Left Channel"};
+    inline const SignalKey<std::vector<int32_t>> MicrophoneRightChannel{"Microphone Right Channel"};
+
+    //Audio Signals
+    inline const SignalKey<std::vector<float>> FFTBands{"FFT Bands"};
+    inline const SignalKey<std::vector<float>> FFTBandsLeftChannel{"FFT Bands Left Channel"};
+    inline const SignalKey<std::vector<float>> FFTBandsRightChannel{"FFT Bands Right Channel"};
+    inline const SignalKey<BinData> FFTBandsLeftBinData{"FFT Bands Left Bin Data"};
+    inline const SignalKey<BinData> FFTBandsRightBinData{"FFT Bands Right Bin Data"};
+    inline const SignalKey<std::string> AnalysisEngine{"Analysis Engine"};
+    inline const SignalKey<std::string> FFTQueueOverflowPolicy{"FFT Queue Overflow Policy"};
+    inline const SignalKey<std::string> FFTBatchPublishMode{"FFT Batch Publish Mode"};
+    inline const SignalKey<uint32_t> FFTSize{"FFT Size"};
+    inline const SignalKey<uint32_t> FFTHop{"FFT Hop"};
+    inline const SignalKey<float> SpectrumColumnRate{"Spectrum Column Rate"};
+    inline const SignalKey<std::string> SpectrumFormat{"Spectrum Format"};
+    inline const SignalKey<bool> HarmonicPitchDetection{"Harmonic Pitch Detection"};
+
+    //Loudness Signals
+    inline const SignalKey<std::string> LoudnessWeighting{"Loudness Weighting"};
+
+    //Stereo Signals
+    inline const SignalKey<uint32_t> StereoPointBudget{"Stereo Point Budget"};
+
+    //System Signals
+    inline const SignalKey<std::string> CPUUsage{"CPU Usage"};
+    inline const SignalKey<std::string> CPUMemoryUsage{"CPU Memory Usage"};
+    inline const SignalKey<std::string> CPUTemp{"CPU Temp"};
+    inline const SignalKey<std::string> GPUTemp{"GPU Temp"};
+    inline const SignalKey<std::string> ThrottleStatus{"Throttle Status"};
+    inline const SignalKey<std::string> NetRX{"Net RX"};
+    inline const SignalKey<std::string> NetTX{"Net TX"};
+    inline const SignalKey<std::string> DiskUsage{"Disk Usage"};
+    inline const SignalKey<std::string> LoadAvg{"Load Avg"};
+    inline const SignalKey<std::string> Uptime{"Uptime"};
+    inline const SignalKey<std::vector<SignalStatsEntry>> SignalStats{"Signal Stats"};
+
+    //Rendering Signals
+    inline const SignalKey<std::string> ColorMappingType{"Color Mapping Type"};
+
+    //Sensitivity and Threshold Signals
+    inline const SignalKey<float> MinDb{"Min db"};
+    inline const SignalKey<float> MaxDb{"Max db"};
+    inline const SignalKey<std::string> DbRangeMode{"db Range Mode"};
+
+    //Brightness and Current Signals
+    inline const SignalKey<float> CalculatedCurrent{"Calculated Current"};
+    inline const SignalKey<uint32_t> CurrentLimit{"Current Limit"};
+    inline const SignalKey<float> Brightness{"Brightness"};
+    inline const SignalKey<uint8_t> LEDDriverLimit{"LED Driver Limit"};
+
+    //Render Frequency Signals
+    inline const SignalKey<float> MinimumRenderFrequency{"Minimum Render Frequency"};
+    inline const SignalKey<float> MaximumRenderFrequency{"Maximum Render Frequency"};
+}
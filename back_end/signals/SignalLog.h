@@ -0,0 +1,373 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
+#include <stdexcept>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * Signal log segment and index files, written by SignalRecorder and read by SignalReplay.
+ *
+ * Both files start with the same header:
+ * ---------------------------------------------------------------
+ * | Offset | Field         | Size          | Description         |
+ * |--------|---------------|---------------|---------------------|
+ * | 0      | magic         | 8 bytes       | "SIGLOG01" or "SIGIDX01" |
+ * | 8      | version       | 4 bytes       | uint32_t, always 1  |
+ * | 12     | reserved      | 4 bytes       | 0                   |
+ * | 16     | start_time    | 8 bytes       | uint64_t, ms since epoch when recording started |
+ * | 24     | data_end      | 8 bytes       | uint64_t, file offset after the last complete entry |
+ *
+ * Segment record:
+ * | 0      | record_length | 4 bytes       | uint32_t, including this header |
+ * | 4      | offset        | 8 bytes       | uint64_t, ns since recording started |
+ * | 12     | entry_format  | 1 byte        | 0 = text, 1 = binary |
+ * | 13     | name_length   | 2 bytes       | uint16_t            |
+ * | 15     | signal_name   | N bytes       | UTF-8               |
+ * | 15+N   | message       | rest          | The signal's own websocket message |
+ *
+ * Index entry, one per INDEX_INTERVAL_NS of recording:
+ * | 0      | offset        | 8 bytes       | uint64_t, offset of the indexed record |
+ * | 8      | file_offset   | 8 bytes       | uint64_t, segment file offset of that record |
+ *
+ * Notes:
+ * - Fields are in host byte order, logs are read back on the machine that wrote them or one like it.
+ * - data_end is updated after every entry, so a log cut short by a crash still reads up to its last entry.
+ */
+namespace SignalLog
+{
+    inline constexpr char SEGMENT_MAGIC[8] = {'S', 'I', 'G', 'L', 'O', 'G', '0', '1'};
+    inline constexpr char INDEX_MAGIC[8] = {'S', 'I', 'G', 'I', 'D', 'X', '0', '1'};
+    inline constexpr uint32_t VERSION = 1;
+    inline constexpr size_t HEADER_SIZE = 32;
+    inline constexpr size_t RECORD_HEADER_SIZE = 4 + 8 + 1 + 2;
+    inline constexpr size_t INDEX_ENTRY_SIZE = 16;
+    inline constexpr uint64_t INDEX_INTERVAL_NS = 100'000'000;
+
+    enum class EntryFormat : uint8_t
+    {
+        Text = 0,
+        Binary = 1,
+    };
+
+    struct Record
+    {
+        uint64_t offsetNs;
+        EntryFormat format;
+        std::string name;
+        const uint8_t* message;
+        size_t messageSize;
+    };
+
+    struct IndexEntry
+    {
+        uint64_t offsetNs;
+        uint64_t fileOffset;
+    };
+
+    inline std::string segmentFileName(size_t sequence)
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "segment-%06zu.seg", sequence);
+        return name;
+    }
+
+    inline std::string indexFileName(const std::string& segmentPath)
+    {
+        return segmentPath + ".idx";
+    }
+
+    // A preallocated file mapped for writing. Entries are copied into the mapping and only the header's
+    // data_end makes them visible, the file is trimmed to data_end when closed.
+    class MappedAppendFile
+    {
+        public:
+            MappedAppendFile(const std::string& path, const char (&magic)[8], uint64_t startTimeMs, size_t capacity)
+                : path_(path)
+                , capacity_(std::max(capacity, HEADER_SIZE))
+            {
+                fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+                if (fd_ < 0)
+                {
+                    throw std::runtime_error("SignalLog: Cannot create " + path + ": " + std::strerror(errno));
+                }
+                if (::ftruncate(fd_, static_cast<off_t>(capacity_)) != 0)
+                {
+                    ::close(fd_);
+                    throw std::runtime_error("SignalLog: Cannot size " + path + ": " + std::strerror(errno));
+                }
+                void* mapping = ::mmap(nullptr, capacity_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+                if (mapping == MAP_FAILED)
+                {
+                    ::close(fd_);
+                    throw std::runtime_error("SignalLog: Cannot map " + path + ": " + std::strerror(errno));
+                }
+                data_ = static_cast<uint8_t*>(mapping);
+
+                std::memcpy(data_, magic, 8);
+                write32(8, VERSION);
+                write32(12, 0);
+                write64(16, startTimeMs);
+                used_ = HEADER_SIZE;
+                write64(24, used_);
+            }
+
+            ~MappedAppendFile()
+            {
+                close();
+            }
+
+            MappedAppendFile(const MappedAppendFile&) = delete;
+            MappedAppendFile& operator=(const MappedAppendFile&) = delete;
+
+            size_t remaining() const { return capacity_ - used_; }
+            size_t size() const { return used_; }
+
+            // Reserves size bytes at the end, the caller fills them and then calls commit.
+            uint8_t* reserve(size_t size)
+            {
+                return size <= remaining() ? data_ + used_ : nullptr;
+            }
+
+            void commit(size_t size)
+            {
+                used_ += size;
+                write64(24, used_);
+            }
+
+            void close()
+            {
+                if (!data_)
+                {
+                    return;
+                }
+                ::msync(data_, used_, MS_ASYNC);
+                ::munmap(data_, capacity_);
+                data_ = nullptr;
+                // If trimming fails the file keeps its preallocated tail, data_end still marks the end.
+                const bool trimmed = ::ftruncate(fd_, static_cast<off_t>(used_)) == 0;
+                static_cast<void>(trimmed);
+                ::close(fd_);
+                fd_ = -1;
+            }
+
+        private:
+            void write32(size_t offset, uint32_t v) { std::memcpy(data_ + offset, &v, sizeof(v)); }
+            void write64(size_t offset, uint64_t v) { std::memcpy(data_ + offset, &v, sizeof(v)); }
+
+            std::string path_;
+            size_t capacity_;
+            int fd_ = -1;
+            uint8_t* data_ = nullptr;
+            size_t used_ = 0;
+    };
+
+    // A complete segment or index file mapped read only.
+    class MappedFile
+    {
+        public:
+            MappedFile(const std::string& path, const char (&magic)[8])
+            {
+                fd_ = ::open(path.c_str(), O_RDONLY);
+                if (fd_ < 0)
+                {
+                    throw std::runtime_error("SignalLog: Cannot open " + path + ": " + std::strerror(errno));
+                }
+                struct stat st;
+                if (::fstat(fd_, &st) != 0 || static_cast<size_t>(st.st_size) < HEADER_SIZE)
+                {
+                    ::close(fd_);
+                    throw std::runtime_error("SignalLog: " + path + " is too short");
+                }
+                size_ = static_cast<size_t>(st.st_size);
+                void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+                if (mapping == MAP_FAILED)
+                {
+                    ::close(fd_);
+                    throw std::runtime_error("SignalLog: Cannot map " + path + ": " + std::strerror(errno));
+                }
+                data_ = static_cast<const uint8_t*>(mapping);
+
+                uint32_t version;
+                std::memcpy(&version, data_ + 8, sizeof(version));
+                if (std::memcmp(data_, magic, 8) != 0 || version != VERSION)
+                {
+                    unmap();
+                    throw std::runtime_error("SignalLog: " + path + " is not a version 1 signal log file");
+                }
+                std::memcpy(&startTimeMs_, data_ + 16, sizeof(startTimeMs_));
+                uint64_t dataEnd;
+                std::memcpy(&dataEnd, data_ + 24, sizeof(dataEnd));
+                dataEnd_ = static_cast<size_t>(std::clamp<uint64_t>(dataEnd, HEADER_SIZE, size_));
+            }
+
+            ~MappedFile()
+            {
+                unmap();
+            }
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            const uint8_t* data() const { return data_; }
+            size_t dataEnd() const { return dataEnd_; }
+            uint64_t startTimeMs() const { return startTimeMs_; }
+
+        private:
+            void unmap()
+            {
+                if (data_)
+                {
+                    ::munmap(const_cast<uint8_t*>(data_), size_);
+                    data_ = nullptr;
+                }
+                if (fd_ >= 0)
+                {
+                    ::close(fd_);
+                    fd_ = -1;
+                }
+            }
+
+            int fd_ = -1;
+            const uint8_t* data_ = nullptr;
+            size_t size_ = 0;
+            size_t dataEnd_ = HEADER_SIZE;
+            uint64_t startTimeMs_ = 0;
+    };
+
+    // Writes one segment and its index.
+    class SegmentWriter
+    {
+        public:
+            SegmentWriter(const std::string& path, uint64_t startTimeMs, size_t capacity)
+                : segment_(path, SEGMENT_MAGIC, startTimeMs, capacity)
+                , index_(indexFileName(path), INDEX_MAGIC, startTimeMs, HEADER_SIZE + (capacity / 1024 + 64) * INDEX_ENTRY_SIZE)
+            {
+            }
+
+            // False when the record does not fit, the caller rolls to a new segment.
+            bool append(uint64_t offsetNs, EntryFormat format, const std::string& name, const uint8_t* message, size_t messageSize)
+            {
+                const size_t size = RECORD_HEADER_SIZE + name.size() + messageSize;
+                uint8_t* out = segment_.reserve(size);
+                if (!out || size > UINT32_MAX)
+                {
+                    return false;
+                }
+
+                const uint64_t fileOffset = segment_.size();
+                const uint32_t length = static_cast<uint32_t>(size);
+                const uint16_t nameLength = static_cast<uint16_t>(name.size());
+                std::memcpy(out, &length, 4);
+                std::memcpy(out + 4, &offsetNs, 8);
+                out[12] = static_cast<uint8_t>(format);
+                std::memcpy(out + 13, &nameLength, 2);
+                std::memcpy(out + RECORD_HEADER_SIZE, name.data(), name.size());
+                std::memcpy(out + RECORD_HEADER_SIZE + name.size(), message, messageSize);
+                segment_.commit(size);
+
+                if (!indexed_ || offsetNs >= nextIndexNs_)
+                {
+                    // A full index only loses seek precision, the records themselves are unaffected.
+                    if (uint8_t* entry = index_.reserve(INDEX_ENTRY_SIZE))
+                    {
+                        std::memcpy(entry, &offsetNs, 8);
+                        std::memcpy(entry + 8, &fileOffset, 8);
+                        index_.commit(INDEX_ENTRY_SIZE);
+                    }
+                    indexed_ = true;
+                    nextIndexNs_ = offsetNs + INDEX_INTERVAL_NS;
+                }
+                return true;
+            }
+
+            bool isEmpty() const { return segment_.size() == HEADER_SIZE; }
+
+        private:
+            MappedAppendFile segment_;
+            MappedAppendFile index_;
+            bool indexed_ = false;
+            uint64_t nextIndexNs_ = 0;
+    };
+
+    // Reads the records of one segment in order, optionally starting from an index lookup.
+    class SegmentReader
+    {
+        public:
+            explicit SegmentReader(const std::string& path)
+                : segment_(path, SEGMENT_MAGIC)
+                , position_(HEADER_SIZE)
+                , path_(path)
+            {
+            }
+
+            uint64_t startTimeMs() const { return segment_.startTimeMs(); }
+
+            // Positions the reader at the last indexed record at or before offsetNs. Without an index it reads from the start.
+            void seek(uint64_t offsetNs)
+            {
+                position_ = HEADER_SIZE;
+                try
+                {
+                    MappedFile index(indexFileName(path_), INDEX_MAGIC);
+                    const size_t count = (index.dataEnd() - HEADER_SIZE) / INDEX_ENTRY_SIZE;
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        IndexEntry entry;
+                        std::memcpy(&entry.offsetNs, index.data() + HEADER_SIZE + i * INDEX_ENTRY_SIZE, 8);
+                        std::memcpy(&entry.fileOffset, index.data() + HEADER_SIZE + i * INDEX_ENTRY_SIZE + 8, 8);
+                        if (entry.offsetNs > offsetNs)
+                        {
+                            break;
+                        }
+                        if (entry.fileOffset >= HEADER_SIZE && entry.fileOffset < segment_.dataEnd())
+                        {
+                            position_ = static_cast<size_t>(entry.fileOffset);
+                        }
+                    }
+                }
+                catch (const std::exception&)
+                {
+                    // No usable index, reading from the start is still correct.
+                }
+            }
+
+            // The record stays valid for the lifetime of the reader.
+            bool next(Record& record)
+            {
+                if (position_ + RECORD_HEADER_SIZE > segment_.dataEnd())
+                {
+                    return false;
+                }
+                const uint8_t* in = segment_.data() + position_;
+                uint32_t length;
+                uint16_t nameLength;
+                std::memcpy(&length, in, 4);
+                std::memcpy(&record.offsetNs, in + 4, 8);
+                record.format = static_cast<EntryFormat>(in[12]);
+                std::memcpy(&nameLength, in + 13, 2);
+                if (length < RECORD_HEADER_SIZE + nameLength || position_ + length > segment_.dataEnd())
+                {
+                    return false;
+                }
+                record.name.assign(reinterpret_cast<const char*>(in + RECORD_HEADER_SIZE), nameLength);
+                record.message = in + RECORD_HEADER_SIZE + nameLength;
+                record.messageSize = length - RECORD_HEADER_SIZE - nameLength;
+                position_ += length;
+                return true;
+            }
+
+        private:
+            MappedFile segment_;
+            size_t position_;
+            std::string path_;
+    };
+}
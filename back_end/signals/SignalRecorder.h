@@ -0,0 +1,186 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <filesystem>
+#include "signal.h"
+#include "SignalLog.h"
+#include "../logger.h"
+
+// Captures what the pipeline produced for later replay. Each selected signal's values are encoded with
+// the signal's own websocket encoder on the recorder's executor and appended to memory mapped segment
+// files under <directory>/<start time ms>/, see SignalLog.h for the layout.
+class SignalRecorder
+{
+    public:
+        static constexpr size_t DEFAULT_SEGMENT_BYTES = 64 << 20;
+        static constexpr const char* EXECUTOR_NAME = "Signal Recorder";
+
+        SignalRecorder( const std::string& directory
+                      , const std::vector<std::string>& signalNames
+                      , size_t segmentBytes = DEFAULT_SEGMENT_BYTES )
+            : directory_(directory)
+            , signalNames_(signalNames)
+            , segmentBytes_(segmentBytes)
+            , logger_(initializeLogger("Signal Recorder", spdlog::level::info))
+            , rateLimitedLog_(std::make_shared<RateLimitedLogger>(logger_, std::chrono::seconds(10)))
+        {
+        }
+
+        ~SignalRecorder()
+        {
+            stop();
+        }
+
+        SignalRecorder(const SignalRecorder&) = delete;
+        SignalRecorder& operator=(const SignalRecorder&) = delete;
+
+        void start()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (recording_)
+            {
+                return;
+            }
+
+            const uint64_t startTimeMs = binary_timestamp_ms();
+            recordingPath_ = (std::filesystem::path(directory_) / std::to_string(startTimeMs)).string();
+            std::error_code error;
+            std::filesystem::create_directories(recordingPath_, error);
+            if (error)
+            {
+                logger_->error("Signal Recorder: Cannot create {}: {}", recordingPath_, error.message());
+                return;
+            }
+            startTime_ = std::chrono::steady_clock::now();
+            startTimeMs_ = startTimeMs;
+            sequence_ = 0;
+            openSegment();
+            if (!writer_)
+            {
+                return;
+            }
+            recording_ = true;
+
+            for (const std::string& name : signalNames_)
+            {
+                auto signal = SignalManager::getInstance().getSharedSignalByName(name);
+                if (!signal)
+                {
+                    logger_->warn("Signal Recorder: Signal \"{}\" not found, not recording it.", name);
+                    continue;
+                }
+                if (signal->registerEncodedValueCallback([this, name](const std::shared_ptr<WebSocketMessage>& message, std::chrono::steady_clock::time_point publishedAt)
+                    {
+                        append(name, message, publishedAt);
+                    }, this, EXECUTOR_NAME, [this, name]()
+                    {
+                        ++droppedRecords_;
+                        rateLimitedLog_->log("queue full", spdlog::level::warn, "Signal Recorder: Queue full, dropped a record of \"{}\".", name);
+                    }))
+                {
+                    signals_.push_back(signal);
+                }
+            }
+            logger_->info("Signal Recorder: Recording {} signals to {}.", signals_.size(), recordingPath_);
+        }
+
+        void stop()
+        {
+            std::vector<std::shared_ptr<SignalName>> signals;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!recording_)
+                {
+                    return;
+                }
+                signals.swap(signals_);
+            }
+            // Outside mutex_, unregistering waits for an append that may be running.
+            for (const auto& signal : signals)
+            {
+                signal->unregisterEncodedValueCallback(this);
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            writer_.reset();
+            recording_ = false;
+            logger_->info("Signal Recorder: Stopped, {} records in {} segments.", recordedRecords_.load(), sequence_);
+        }
+
+        const std::string& getRecordingPath() const { return recordingPath_; }
+        uint64_t getRecordedRecords() const { return recordedRecords_.load(); }
+        uint64_t getDroppedRecords() const { return droppedRecords_.load(); }
+
+    private:
+        // Runs on the recorder executor, one record at a time. The offset is the publish time, not the time
+        // the record reaches the front of the queue.
+        void append(const std::string& name, const std::shared_ptr<WebSocketMessage>& message, std::chrono::steady_clock::time_point publishedAt)
+        {
+            const uint64_t offsetNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::max(publishedAt, startTime_) - startTime_).count());
+            const bool binary = message->webSocket_Message_type == WebSocketMessageType::Binary;
+            const SignalLog::EntryFormat format = binary ? SignalLog::EntryFormat::Binary : SignalLog::EntryFormat::Text;
+            const uint8_t* data = binary ? message->binary_data.data() : reinterpret_cast<const uint8_t*>(message->message.data());
+            const size_t size = binary ? message->binary_data.size() : message->message.size();
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!writer_)
+            {
+                return;
+            }
+            bool appended = writer_->append(offsetNs, format, name, data, size);
+            if (!appended && !writer_->isEmpty())
+            {
+                openSegment();
+                appended = writer_ && writer_->append(offsetNs, format, name, data, size);
+            }
+            if (appended)
+            {
+                ++recordedRecords_;
+            }
+            else
+            {
+                ++droppedRecords_;
+                rateLimitedLog_->log("dropped", spdlog::level::warn, "Signal Recorder: Dropped a {} byte record of \"{}\".", size, name);
+            }
+        }
+
+        // Called with mutex_ held.
+        void openSegment()
+        {
+            writer_.reset();
+            const std::string path = (std::filesystem::path(recordingPath_) / SignalLog::segmentFileName(sequence_)).string();
+            try
+            {
+                writer_ = std::make_unique<SignalLog::SegmentWriter>(path, startTimeMs_, segmentBytes_);
+                ++sequence_;
+            }
+            catch (const std::exception& e)
+            {
+                logger_->error("Signal Recorder: {}", e.what());
+            }
+        }
+
+        std::string directory_;
+        std::vector<std::string> signalNames_;
+        size_t segmentBytes_;
+        std::shared_ptr<spdlog::logger> logger_;
+        std::shared_ptr<RateLimitedLogger> rateLimitedLog_;
+
+        std::mutex mutex_;
+        bool recording_ = false;
+        std::string recordingPath_;
+        std::chrono::steady_clock::time_point startTime_;
+        uint64_t startTimeMs_ = 0;
+        size_t sequence_ = 0;
+        std::unique_ptr<SignalLog::SegmentWriter> writer_;
+        std::vector<std::shared_ptr<SignalName>> signals_;
+        std::atomic<uint64_t> recordedRecords_{0};
+        std::atomic<uint64_t> droppedRecords_{0};
+};
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <filesystem>
+#include <unordered_map>
+#include <condition_variable>
+#include "signal.h"
+#include "SignalLog.h"
+#include "../logger.h"
+
+// Feeds a recording made by SignalRecorder back into SignalManager, for reproducing a problem offline.
+// Text records go through setValueFromJSON and binary records through the signal's binary decoder,
+// records of signals without one are skipped.
+class SignalReplay
+{
+    public:
+        // speed 1 keeps the recorded timing, 2 replays twice as fast and 0 as fast as the signals take it.
+        SignalReplay(const std::string& recordingPath, float speed = 1.0f, uint64_t startOffsetMs = 0)
+            : recordingPath_(recordingPath)
+            , speed_(std::max(0.0f, speed))
+            , startOffsetNs_(startOffsetMs * 1'000'000)
+            , logger_(initializeLogger("Signal Replay", spdlog::level::info))
+            , rateLimitedLog_(std::make_shared<RateLimitedLogger>(logger_, std::chrono::seconds(10)))
+        {
+        }
+
+        ~SignalReplay()
+        {
+            stop();
+        }
+
+        SignalReplay(const SignalReplay&) = delete;
+        SignalReplay& operator=(const SignalReplay&) = delete;
+
+        void start()
+        {
+            if (thread_.joinable())
+            {
+                return;
+            }
+            stop_ = false;
+            running_ = true;
+            thread_ = std::thread(&SignalReplay::run, this);
+        }
+
+        void stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            cv_.notify_all();
+            if (thread_.joinable())
+            {
+                thread_.join();
+            }
+        }
+
+        bool isRunning() const { return running_.load(); }
+        uint64_t getReplayedRecords() const { return replayedRecords_.load(); }
+        uint64_t getSkippedRecords() const { return skippedRecords_.load(); }
+
+    private:
+        void run()
+        {
+            std::vector<std::string> segments;
+            std::error_code error;
+            for (const auto& entry : std::filesystem::directory_iterator(recordingPath_, error))
+            {
+                if (entry.path().extension() == ".seg")
+                {
+                    segments.push_back(entry.path().string());
+                }
+            }
+            if (error || segments.empty())
+            {
+                logger_->error("Signal Replay: No segments found in {}.", recordingPath_);
+                running_ = false;
+                return;
+            }
+            // Segment names are zero padded sequence numbers, so name order is recording order.
+            std::sort(segments.begin(), segments.end());
+            logger_->info("Signal Replay: Replaying {} segments from {} at {}x.", segments.size(), recordingPath_, speed_);
+
+            const auto replayStart = std::chrono::steady_clock::now();
+            for (const std::string& path : segments)
+            {
+                try
+                {
+                    SignalLog::SegmentReader reader(path);
+                    reader.seek(startOffsetNs_);
+                    SignalLog::Record record;
+                    while (reader.next(record))
+                    {
+                        if (record.offsetNs < startOffsetNs_)
+                        {
+                            continue;
+                        }
+                        if (!waitUntilDue(replayStart, record.offsetNs - startOffsetNs_))
+                        {
+                            running_ = false;
+                            return;
+                        }
+                        apply(record);
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    logger_->error("Signal Replay: {}", e.what());
+                }
+            }
+            logger_->info("Signal Replay: Finished, {} records replayed, {} skipped.", replayedRecords_.load(), skippedRecords_.load());
+            running_ = false;
+        }
+
+        // False when stopped while waiting.
+        bool waitUntilDue(std::chrono::steady_clock::time_point replayStart, uint64_t elapsedNs)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (speed_ > 0.0f)
+            {
+                const auto due = replayStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double, std::nano>(static_cast<double>(elapsedNs) / speed_));
+                cv_.wait_until(lock, due, [this] { return stop_; });
+            }
+            return !stop_;
+        }
+
+        void apply(const SignalLog::Record& record)
+        {
+            std::shared_ptr<SignalName>& signal = signals_[record.name];
+            if (!signal)
+            {
+                signal = SignalManager::getInstance().getSharedSignalByName(record.name);
+            }
+
+            bool applied = false;
+            if (signal && record.format == SignalLog::EntryFormat::Text)
+            {
+                json j = json::parse(record.message, record.message + record.messageSize, nullptr, false);
+                applied = !j.is_discarded() && j.contains("value") && signal->setValueFromJSON(j["value"]);
+            }
+            else if (signal)
+            {
+                applied = signal->setValueFromBinary(record.message, record.messageSize);
+            }
+
+            if (applied)
+            {
+                ++replayedRecords_;
+            }
+            else
+            {
+                ++skippedRecords_;
+                rateLimitedLog_->log("skipped " + record.name, spdlog::level::warn, "Signal Replay: Skipped a record of \"{}\", signal missing or cannot take it.", record.name);
+            }
+        }
+
+        std::string recordingPath_;
+        float speed_;
+        uint64_t startOffsetNs_;
+        std::shared_ptr<spdlog::logger> logger_;
+        std::shared_ptr<RateLimitedLogger> rateLimitedLog_;
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        bool stop_ = false;
+        std::atomic<bool> running_{false};
+        std::thread thread_;
+        std::unordered_map<std::string, std::shared_ptr<SignalName>> signals_;     // Replay thread only
+        std::atomic<uint64_t> replayedRecords_{0};
+        std::atomic<uint64_t> skippedRecords_{0};
+};
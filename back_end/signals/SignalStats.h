@@ -0,0 +1,125 @@
+#pragma once
+
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "DataTypesAndEncoders/SignalStatsEntry.h"
+
+// Per-signal cost counters, built in with SIGNAL_STATS (the CMake option, on by default). Without it the
+// counters and timers are empty and every record call compiles to nothing.
+
+// Measures from construction. Reads the clock only when stats are built in.
+class SignalStatsTimer
+{
+    public:
+#ifdef SIGNAL_STATS
+        SignalStatsTimer() : start_(std::chrono::steady_clock::now()) {}
+
+        uint64_t elapsedNs() const
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start_).count());
+        }
+
+    private:
+        std::chrono::steady_clock::time_point start_;
+#else
+        uint64_t elapsedNs() const { return 0; }
+#endif
+};
+
+// Shared by a registered callback and its queued deliveries.
+class CallbackStats
+{
+    public:
+#ifdef SIGNAL_STATS
+        void record(uint64_t ns)
+        {
+            calls_.fetch_add(1, std::memory_order_relaxed);
+            totalNs_.fetch_add(ns, std::memory_order_relaxed);
+            uint64_t max = maxNs_.load(std::memory_order_relaxed);
+            while (ns > max && !maxNs_.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {}
+        }
+
+        SubscriberStats snapshot(const std::string& subscriber) const
+        {
+            return SubscriberStats{subscriber, calls_.load(std::memory_order_relaxed), totalNs_.load(std::memory_order_relaxed), maxNs_.load(std::memory_order_relaxed)};
+        }
+
+    private:
+        std::atomic<uint64_t> calls_{0};
+        std::atomic<uint64_t> totalNs_{0};
+        std::atomic<uint64_t> maxNs_{0};
+#else
+        void record(uint64_t) {}
+
+        SubscriberStats snapshot(const std::string& subscriber) const
+        {
+            return SubscriberStats{subscriber};
+        }
+#endif
+};
+
+class SignalStats
+{
+    public:
+#ifdef SIGNAL_STATS
+        void recordSet(bool published, uint64_t compareNs)
+        {
+            sets_.fetch_add(1, std::memory_order_relaxed);
+            if (published)
+            {
+                publishes_.fetch_add(1, std::memory_order_relaxed);
+            }
+            compareNs_.fetch_add(compareNs, std::memory_order_relaxed);
+        }
+
+        void recordEncode(uint64_t ns, size_t bytes)
+        {
+            encodes_.fetch_add(1, std::memory_order_relaxed);
+            encodeNs_.fetch_add(ns, std::memory_order_relaxed);
+            encodedBytes_.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        void recordWebSocketSend() { webSocketSends_.fetch_add(1, std::memory_order_relaxed); }
+        void recordWebSocketConflated() { webSocketConflated_.fetch_add(1, std::memory_order_relaxed); }
+
+        SignalStatsEntry snapshot(const std::string& name) const
+        {
+            SignalStatsEntry entry;
+            entry.name = name;
+            entry.sets = sets_.load(std::memory_order_relaxed);
+            entry.publishes = publishes_.load(std::memory_order_relaxed);
+            entry.compareNs = compareNs_.load(std::memory_order_relaxed);
+            entry.encodes = encodes_.load(std::memory_order_relaxed);
+            entry.encodeNs = encodeNs_.load(std::memory_order_relaxed);
+            entry.encodedBytes = encodedBytes_.load(std::memory_order_relaxed);
+            entry.webSocketSends = webSocketSends_.load(std::memory_order_relaxed);
+            entry.webSocketConflated = webSocketConflated_.load(std::memory_order_relaxed);
+            return entry;
+        }
+
+    private:
+        std::atomic<uint64_t> sets_{0};
+        std::atomic<uint64_t> publishes_{0};
+        std::atomic<uint64_t> compareNs_{0};
+        std::atomic<uint64_t> encodes_{0};
+        std::atomic<uint64_t> encodeNs_{0};
+        std::atomic<uint64_t> encodedBytes_{0};
+        std::atomic<uint64_t> webSocketSends_{0};
+        std::atomic<uint64_t> webSocketConflated_{0};
+#else
+        void recordSet(bool, uint64_t) {}
+        void recordEncode(uint64_t, size_t) {}
+        void recordWebSocketSend() {}
+        void recordWebSocketConflated() {}
+
+        SignalStatsEntry snapshot(const std::string& name) const
+        {
+            SignalStatsEntry entry;
+            entry.name = name;
+            return entry;
+        }
+#endif
+};
@@ -1,6 +1,43 @@
 #include "signal.h"
+#include <algorithm>
 
 
+namespace
+{
+    struct SignalKeyTypes
+    {
+        std::mutex mutex;
+        std::unordered_map<std::string, std::type_index> types;
+    };
+
+    // Keys register during static initialization, so the table is built on first use.
+    SignalKeyTypes& signalKeyTypes()
+    {
+        static SignalKeyTypes* keyTypes = new SignalKeyTypes();
+        return *keyTypes;
+    }
+}
+
+void registerSignalKeyType(const char* name, std::type_index type)
+{
+    SignalKeyTypes& keyTypes = signalKeyTypes();
+    std::lock_guard<std::mutex> lock(keyTypes.mutex);
+    auto [it, inserted] = keyTypes.types.emplace(name, type);
+    if (!inserted && it->second != type)
+    {
+        throw std::logic_error(std::string("Signal key \"") + name + "\" is declared with two value types");
+    }
+}
+
+const std::type_index* findSignalKeyType(const std::string& name)
+{
+    SignalKeyTypes& keyTypes = signalKeyTypes();
+    std::lock_guard<std::mutex> lock(keyTypes.mutex);
+    auto it = keyTypes.types.find(name);
+    // Entries are never erased, the pointer stays valid after the lock is released.
+    return (it != keyTypes.types.end()) ? &it->second : nullptr;
+}
+
 SignalManager& SignalManager::getInstance()
 {
     static SignalManager instance;
@@ -29,3 +66,111 @@ std::shared_ptr<SignalName> SignalManager::getSharedSignalByName(const std::stri
     auto it = signals_.find(name);
     return (it != signals_.end()) ? it->second : nullptr;
 }
+
+void SignalBatch::stage(Entry entry)
+{
+    for (Entry& staged : entries_)
+    {
+        if (staged.signal == entry.signal)
+        {
+            staged = std::move(entry);
+            return;
+        }
+    }
+    entries_.push_back(std::move(entry));
+}
+
+size_t SignalManager::commit(SignalBatch& batch, void* arg)
+{
+    std::vector<std::shared_ptr<SignalName>> changed;
+    changed.reserve(batch.getEntries().size());
+    {
+        // Only pointer swaps under the lock, a slow subscriber never holds up other committers.
+        std::lock_guard<std::mutex> lock(batch_mutex_);
+        for (const auto& entry : batch.getEntries())
+        {
+            if (entry.signal->storeBatchValue(entry.value, entry.versioned ? &entry.version : nullptr))
+            {
+                changed.push_back(entry.signal);
+            }
+        }
+    }
+    batch.clear();
+    for (const auto& signal : changed)
+    {
+        signal->notifyBatchClients(arg);
+    }
+
+    // One broadcast per server, signals normally all share the same one.
+    std::vector<std::pair<std::shared_ptr<WebSocketServer>, std::vector<std::pair<std::string, std::shared_ptr<WebSocketMessage>>>>> broadcasts;
+    for (const auto& signal : changed)
+    {
+        auto message = signal->takeBatchWebSocketMessage();
+        auto server = message ? signal->getWebSocketServer() : nullptr;
+        if (!server)
+        {
+            continue;
+        }
+        auto it = std::find_if(broadcasts.begin(), broadcasts.end(), [&server](const auto& broadcast) { return broadcast.first == server; });
+        if (it == broadcasts.end())
+        {
+            it = broadcasts.emplace(broadcasts.end(), server, std::vector<std::pair<std::string, std::shared_ptr<WebSocketMessage>>>());
+        }
+        it->second.emplace_back(signal->getName(), std::move(message));
+    }
+    for (const auto& [server, messages] : broadcasts)
+    {
+        server->broadcast_signals_to_websocket(messages);
+    }
+    return changed.size();
+}
+
+std::vector<SignalStatsEntry> SignalManager::getStats()
+{
+    std::vector<std::shared_ptr<SignalName>> signals;
+    {
+        std::lock_guard<std::mutex> lock(signal_mutex_);
+        signals.reserve(signals_.size());
+        for (const auto& entry : signals_)
+        {
+            signals.push_back(entry.second);
+        }
+    }
+    // Snapshots are taken outside the lock, a signal's getStats may touch its own callback list.
+    std::vector<SignalStatsEntry> stats;
+    stats.reserve(signals.size());
+    for (const auto& signal : signals)
+    {
+        stats.push_back(signal->getStats());
+    }
+    return stats;
+}
+
+void SignalManager::dumpStats()
+{
+#ifdef SIGNAL_STATS
+    auto stats = getStats();
+    auto cost = [](const SignalStatsEntry& entry)
+    {
+        uint64_t total = entry.compareNs + entry.encodeNs;
+        for (const auto& subscriber : entry.subscribers)
+        {
+            total += subscriber.totalNs;
+        }
+        return total;
+    };
+    std::sort(stats.begin(), stats.end(), [&cost](const SignalStatsEntry& a, const SignalStatsEntry& b) { return cost(a) > cost(b); });
+
+    logger_->info("{:<40} {:>10} {:>10} {:>12} {:>8} {:>12} {:>14} {:>8} {:>10}", "Signal", "Sets", "Publishes", "Compare us", "Encodes", "Encode us", "Encoded bytes", "Sends", "Conflated");
+    for (const auto& entry : stats)
+    {
+        logger_->info("{:<40} {:>10} {:>10} {:>12} {:>8} {:>12} {:>14} {:>8} {:>10}", entry.name, entry.sets, entry.publishes, entry.compareNs / 1000, entry.encodes, entry.encodeNs / 1000, entry.encodedBytes, entry.webSocketSends, entry.webSocketConflated);
+        for (const auto& subscriber : entry.subscribers)
+        {
+            logger_->info("    {:<60} calls {:>10}, total {:>10} us, max {:>8} us", subscriber.subscriber, subscriber.calls, subscriber.totalNs / 1000, subscriber.maxNs / 1000);
+        }
+    }
+#else
+    logger_->warn("Signal stats are not built in, configure with -DSIGNAL_STATS=ON.");
+#endif
+}
@@ -4,13 +4,28 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <atomic>
 #include <vector>
 #include <unordered_map>
 #include <type_traits>
+#include <typeindex>
+#include <cstdint>
+#include <limits>
+#include <chrono>
 #include "../logger.h"
 #include "../websocket_server.h"
+#include "SignalExecutor.h"
+#include "SignalStats.h"
 #include "DataTypesAndEncoders/DataTypesAndEncoders.h"
 
+// Selects entries from a signal's history. Entries are filtered by publish time, then the newest last are kept.
+struct SignalHistoryQuery
+{
+    uint64_t fromMs = 0;
+    uint64_t toMs = std::numeric_limits<uint64_t>::max();
+    size_t last = 0;        // 0 keeps every entry in the range
+};
+
 class SignalName
 {
     public:
@@ -26,10 +41,105 @@ class SignalName
         //Functions to handle at Signal Name Level
         virtual bool setValueFromJSON(const json& j) = 0;
         virtual bool handleWebSocketValueRequest() const = 0;
+        // The current value as a websocket message, for sending to a single session. Null if there is none.
+        virtual std::shared_ptr<WebSocketMessage> getWebSocketValueMessage() const
+        {
+            return nullptr;
+        }
+        // Sent to a session when it subscribes, ahead of the first value. Null if the signal has no layout.
+        virtual std::shared_ptr<WebSocketMessage> getWebSocketLayoutMessage() const
+        {
+            return nullptr;
+        }
+        // The matching history entries as one batched message. Null if the signal keeps no history.
+        virtual std::shared_ptr<WebSocketMessage> getWebSocketHistoryMessage(const SignalHistoryQuery& query) const
+        {
+            return nullptr;
+        }
+
+        using EncodedValueCallback = std::function<void(const std::shared_ptr<WebSocketMessage>&, std::chrono::steady_clock::time_point publishedAt)>;
+        // Every published value encoded with the signal's websocket encoder, delivered in publish order on the
+        // named executor. Lets a consumer that only knows the name, like the recorder, take any signal's values.
+        // dropped runs on the producer for each value the full executor queue did not take.
+        virtual bool registerEncodedValueCallback(EncodedValueCallback cb, void* arg, const std::string& executorName, std::function<void()> dropped = nullptr)
+        {
+            return false;
+        }
+        virtual void unregisterEncodedValueCallback(void* arg) {}
+        // Sets the value from a message the signal's own binary encoder wrote. Only signals given a decoder support it.
+        virtual bool setValueFromBinary(const uint8_t* data, size_t size)
+        {
+            return false;
+        }
+        // Counters since start, empty when built without SIGNAL_STATS.
+        virtual SignalStatsEntry getStats() const
+        {
+            return stats_.snapshot(name_);
+        }
+
+        // SignalBatch hooks. value is a snapshot of the signal's own type, published as it is. version may be null.
+        virtual bool storeBatchValue(const std::shared_ptr<const void>& value, const uint64_t* version)
+        {
+            return false;
+        }
+        // Called once every value of a committed batch is stored.
+        virtual void notifyBatchClients(void* arg) const {}
+        // The message to send for the batch, null when nobody watches or the rate limit holds it back.
+        virtual std::shared_ptr<WebSocketMessage> takeBatchWebSocketMessage() const
+        {
+            return nullptr;
+        }
+        virtual std::shared_ptr<WebSocketServer> getWebSocketServer() const
+        {
+            return nullptr;
+        }
 
     protected:
         const std::string name_;
         std::shared_ptr<spdlog::logger> logger_;
+        mutable SignalStats stats_;
+};
+
+// How setValue decides whether a new value is a change worth publishing.
+enum class ChangeDetection
+{
+    CompareValue,       // Element-wise compare against the current value (default)
+    AlwaysPublish,      // Every setValue publishes, for streams that change on every update
+    ProducerVersion     // Producer passes a version with setVersionedValue, only a new version publishes
+};
+
+// Websocket publish rate for signals that only feed browser views, which cannot draw faster than this.
+inline constexpr float WEBSOCKET_DISPLAY_RATE_HZ = 60.0f;
+// History kept for scrolling views, enough to fill the tallest one on connect.
+inline constexpr size_t WEBSOCKET_DISPLAY_HISTORY_ENTRIES = 1024;
+
+// Records the value type a key declares for its name. Throws when the name is already declared with another
+// type, which during static initialization stops the program before main.
+void registerSignalKeyType(const char* name, std::type_index type);
+// The value type declared for name, or null when no key declares it.
+const std::type_index* findSignalKeyType(const std::string& name);
+
+// A signal name bound to its value type at compile time. Keys are declared once in SignalKeys.h, so a
+// misspelled name or a wrong value type is a compile error instead of a null signal at runtime. Declaring a
+// key also registers its type, a signal of that name created with any other type throws at init.
+template<typename T>
+struct SignalKey
+{
+    using ValueType = T;
+    const char* name;
+
+    explicit SignalKey(const char* keyName) : name(keyName)
+    {
+        registerSignalKeyType(name, std::type_index(typeid(T)));
+    }
+};
+
+// Where a registered callback runs when the signal publishes.
+enum class CallbackDispatch
+{
+    Inline,         // On the producer's thread, before setValue returns (default)
+    Queued,         // Every value is posted to the named executor, in publish order
+    LatestValue     // Posted to the named executor, values published while one is pending replace it
 };
 
 template<typename T>
@@ -37,14 +147,43 @@ class SignalValue: public SignalName
 {
     public:
         SignalValue(const std::string& name) : SignalName(name)
-                                             , data_(std::make_shared<T>()) {}
+                                             , data_(std::make_shared<const T>()) {}
         using SignalValueCallback = std::function<void(const T&, void*)>;
+        using PublishedValueCallback = std::function<void(const T&, void*, std::chrono::steady_clock::time_point publishedAt)>;
+        // Shared with deliveries posted to an executor, so unregistering also stops the ones still queued.
+        struct CallbackDelivery
+        {
+            SignalValueCallback callback;
+            void* arg;
+            std::mutex runMutex;                // Held while the callback runs off the producer thread
+            bool active = true;                 // Guarded by runMutex
+            std::mutex pendingMutex;
+            std::shared_ptr<const T> pending;   // LatestValue: newest snapshot not yet delivered
+            bool posted = false;                // LatestValue: a delivery task is queued
+            PublishedValueCallback publishedCallback;   // Queued: called instead of callback, with the publish time
+            std::function<void()> dropped;              // Queued: runs on the producer when the executor queue is full
+        };
         struct SignalValueCallbackData
         {
             SignalValueCallback callback;
             void* arg;
+            CallbackDispatch dispatch = CallbackDispatch::Inline;
+            std::shared_ptr<SignalExecutor> executor;
+            std::shared_ptr<CallbackDelivery> delivery;     // Null for Inline
+            std::shared_ptr<CallbackStats> stats;
         };
+        static constexpr const char* DEFAULT_EXECUTOR_NAME = "Signal Callbacks";
         virtual bool setValue(const T& value, void* arg = nullptr);
+        // Without ProducerVersion the version is ignored and the policy decides as for setValue.
+        virtual bool setVersionedValue(const T& value, uint64_t version, void* arg = nullptr);
+        void setChangeDetection(ChangeDetection changeDetection)
+        {
+            changeDetection_.store(changeDetection);
+        }
+        ChangeDetection getChangeDetection() const
+        {
+            return changeDetection_.load();
+        }
         virtual bool setValueFromJSON(const json& j) override;
         virtual bool handleWebSocketValueRequest() const override
         {
@@ -52,19 +191,42 @@ class SignalValue: public SignalName
             return false;
         }
         virtual T getValue() const;
-        virtual std::shared_ptr<T> GetData() const
+        // The returned snapshot is never modified, a new value is published as a new snapshot.
+        virtual std::shared_ptr<const T> GetData() const
         {
-            std::lock_guard<std::mutex> lock(dataMutex_);
-            return data_;
+            return std::atomic_load(&data_);
         }
-        void registerSignalValueCallback(SignalValueCallback cb, void* arg = nullptr);
+        void registerSignalValueCallback( SignalValueCallback cb
+                                        , void* arg = nullptr
+                                        , CallbackDispatch dispatch = CallbackDispatch::Inline
+                                        , const std::string& executorName = DEFAULT_EXECUTOR_NAME );
+        // Queued on the named executor, with the time the value was published rather than the time it runs.
+        void registerPublishedValueCallback( PublishedValueCallback cb
+                                           , void* arg
+                                           , const std::string& executorName
+                                           , std::function<void()> dropped = nullptr );
+        // Once this returns the callback is not running and will not be called again, even from an executor.
+        // Must not be called from inside the callback being unregistered.
         void unregisterSignalValueCallbackByArg(void* arg);
 
+        SignalStatsEntry getStats() const override;
+
         virtual ~SignalValue() = default;
     protected:
-        std::shared_ptr<T> data_;
-        mutable std::mutex dataMutex_;
-        std::vector<typename SignalValue<T>::SignalValueCallbackData> callbacks_;
+        // A given snapshot must hold value, it is then published as it is instead of as a copy.
+        bool publish(const T& value, const uint64_t* version, std::shared_ptr<const T> snapshot = nullptr);
+
+        // Immutable snapshot, only ever accessed through std::atomic_load / std::atomic_compare_exchange_strong
+        // so readers never wait on the producer.
+        std::shared_ptr<const T> data_;
+        std::atomic<ChangeDetection> changeDetection_ {ChangeDetection::CompareValue};
+        // Starts at a version no producer counter reaches, so the first versioned value always publishes.
+        std::atomic<uint64_t> lastVersion_ {std::numeric_limits<uint64_t>::max()};
+        static void retireDelivery(const std::shared_ptr<CallbackDelivery>& delivery);
+        void addCallback(SignalValueCallbackData data);
+
+        // Copy on write, replaced under callbackMutex_ and read with std::atomic_load so a publish never takes a lock.
+        std::shared_ptr<const std::vector<SignalValueCallbackData>> callbacks_ = std::make_shared<const std::vector<SignalValueCallbackData>>();
         mutable std::mutex callbackMutex_;
 };
 
@@ -90,9 +252,9 @@ class Signal : public SignalValue<T>
 
         void setup();
         bool setValue(const T& value, void* arg = nullptr) override;
+        bool setVersionedValue(const T& value, uint64_t version, void* arg = nullptr) override;
         void notify()
         {
-            std::lock_guard<std::mutex> lock(this->dataMutex_);
             notifyClients(nullptr);
             if (isUsingWebSocket_)
             {
@@ -109,17 +271,153 @@ class Signal : public SignalValue<T>
         bool handleWebSocketValueRequest() const override
         {
             this->logger_->info("Handle Value requeste for signal \"{}\"", this->name_);
-            return notifyWebSocket();
+            return sendToWebSocket();
+        }
+
+        bool registerEncodedValueCallback(typename SignalName::EncodedValueCallback cb, void* arg, const std::string& executorName, std::function<void()> dropped = nullptr) override;
+        void unregisterEncodedValueCallback(void* arg) override
+        {
+            this->unregisterSignalValueCallbackByArg(arg);
+        }
+        // Set before the signal is in use, e.g. right after creating it.
+        void setBinaryDecoder(BinaryDecoder<T> decoder)
+        {
+            binaryDecoder_ = std::move(decoder);
+        }
+        bool setValueFromBinary(const uint8_t* data, size_t size) override;
+
+        // Encoded once per published value, later requests for the same value reuse the message.
+        std::shared_ptr<WebSocketMessage> getWebSocketValueMessage() const override;
+
+        // Describes how to read the values, e.g. the band labels, so the encoder can leave it out of every frame.
+        void setWebSocketLayout(const json& layout)
+        {
+            std::atomic_store(&layoutMessage_, std::make_shared<WebSocketMessage>(encode_signal_layout(this->name_, layout), priority_, should_retry_));
+        }
+        std::shared_ptr<WebSocketMessage> getWebSocketLayoutMessage() const override
+        {
+            return std::atomic_load(&layoutMessage_);
+        }
+
+        // Keeps the last capacity published values with their publish time, for clients that want context on
+        // connect. Off by default, the ring is allocated here and never grows. 0 turns it off again.
+        void enableHistory(size_t capacity);
+        size_t getHistoryCapacity() const
+        {
+            return historyCapacity_.load();
+        }
+        std::shared_ptr<WebSocketMessage> getWebSocketHistoryMessage(const SignalHistoryQuery& query) const override;
+
+        // Caps how often the value is encoded and sent to websocket clients, 0 sends every change.
+        // Changes inside the interval are conflated, the latest one is sent when the interval ends.
+        void setWebSocketMaxRate(float maxRateHz)
+        {
+            webSocketMaxRate_.store(std::max(0.0f, maxRateHz));
+        }
+        float getWebSocketMaxRate() const
+        {
+            return webSocketMaxRate_.load();
+        }
+
+        bool hasWebSocketSubscribers() const
+        {
+            return !webSocketSubscriberCount_ || webSocketSubscriberCount_->load(std::memory_order_relaxed) > 0;
+        }
+
+        bool storeBatchValue(const std::shared_ptr<const void>& value, const uint64_t* version) override
+        {
+            auto snapshot = std::static_pointer_cast<const T>(value);
+            return storeValue(*snapshot, version, snapshot);
+        }
+        void notifyBatchClients(void* arg) const override
+        {
+            notifyClients(arg);
+        }
+        std::shared_ptr<WebSocketMessage> takeBatchWebSocketMessage() const override;
+        std::shared_ptr<WebSocketServer> getWebSocketServer() const override
+        {
+            return webSocketServer_.lock();
         }
     private:
         std::weak_ptr<WebSocketServer> webSocketServer_;
         JsonEncoder<T> jsonEncoder_;
         BinaryEncoder<T> binaryEncoder_;
+        BinaryDecoder<T> binaryDecoder_;
         MessagePriority priority_;
         bool should_retry_;
         bool isUsingWebSocket_;
+        // Stores without notifying anyone. version and snapshot may be null. True if the value changed.
+        bool storeValue(const T& value, const uint64_t* version, std::shared_ptr<const T> snapshot = nullptr);
         bool notifyClients(void* arg) const;
+        void postLatestValue(const typename SignalValue<T>::SignalValueCallbackData& subscriber, const std::shared_ptr<const T>& snapshot) const;
         bool notifyWebSocket() const;
+        bool webSocketSendDue() const;
+        bool sendToWebSocket() const;
+        // recordStats is false for history replays, so the encode stats only cover live publishes.
+        std::shared_ptr<WebSocketMessage> encodeWebSocketMessage(const T& value, bool recordStats = true) const;
+        void recordHistory();
+
+        struct EncodedValue
+        {
+            std::shared_ptr<const T> value;
+            std::shared_ptr<WebSocketMessage> message;
+        };
+        // Last encoded message and the snapshot it was encoded from, accessed with std::atomic_load / std::atomic_store.
+        mutable std::shared_ptr<const EncodedValue> encodedValue_;
+        std::shared_ptr<WebSocketMessage> layoutMessage_;
+
+        struct HistoryEntry
+        {
+            uint64_t timestampMs = 0;
+            std::shared_ptr<const T> value;     // The published snapshot itself, recording never copies the value
+            std::shared_ptr<WebSocketMessage> message;  // Encoded on the first history request that needs it
+        };
+        std::atomic<size_t> historyCapacity_{0};
+        mutable std::mutex historyMutex_;
+        mutable std::vector<HistoryEntry> history_;     // Ring, guarded by historyMutex_. Requests cache encodes in it
+        size_t historyNext_ = 0;
+        size_t historySize_ = 0;
+        void scheduleTrailingWebSocketPublish() const;
+        std::chrono::steady_clock::duration webSocketInterval() const;
+
+        // Owned by the server and set in setup(). Without it every change is encoded, as before.
+        std::shared_ptr<const std::atomic<size_t>> webSocketSubscriberCount_;
+        std::atomic<float> webSocketMaxRate_{0.0f};
+        mutable std::mutex webSocketRateMutex_;
+        mutable std::chrono::steady_clock::time_point nextWebSocketPublish_;
+        // The timer is only touched on its strand, asio I/O objects are not thread safe.
+        mutable std::unique_ptr<net::strand<net::io_context::executor_type>> webSocketStrand_;
+        mutable std::unique_ptr<net::steady_timer> webSocketTimer_;
+        mutable bool webSocketTrailingPending_ = false;
+};
+
+// Values for several signals, staged here and committed together with SignalManager::commit.
+class SignalBatch
+{
+    public:
+        struct Entry
+        {
+            std::shared_ptr<SignalName> signal;
+            std::shared_ptr<const void> value;      // The snapshot to publish, a const T of the signal's type
+            bool versioned = false;
+            uint64_t version = 0;
+        };
+
+        // Staging a signal again replaces its earlier value, a batch publishes each signal at most once.
+        // The value becomes the published snapshot, pass it with std::move to avoid the copy.
+        template<typename T>
+        SignalBatch& set(const std::shared_ptr<Signal<T>>& signal, T value);
+        template<typename T>
+        SignalBatch& setVersioned(const std::shared_ptr<Signal<T>>& signal, T value, uint64_t version);
+
+        const std::vector<Entry>& getEntries() const { return entries_; }
+        bool empty() const { return entries_.empty(); }
+        void clear() { entries_.clear(); }
+
+    private:
+        void stage(Entry entry);
+
+        std::vector<Entry> entries_;
 };
 
 class SignalManager
@@ -136,6 +434,33 @@ public:
     template<typename T>
     std::shared_ptr<Signal<T>> createSignal(const std::string& name, std::shared_ptr<WebSocketServer> webSocketServer, BinaryEncoder<T> encoder = nullptr);
 
+    // Without an encoder the signal stays internal. The encoder type is taken from the key, so an encoder for
+    // a different value type does not compile.
+    template<typename T>
+    std::shared_ptr<Signal<T>> createSignal(const SignalKey<T>& key);
+
+    template<typename T>
+    std::shared_ptr<Signal<T>> createSignal(const SignalKey<T>& key, std::shared_ptr<WebSocketServer> webSocketServer, JsonEncoder<typename SignalKey<T>::ValueType> encoder);
+
+    template<typename T>
+    std::shared_ptr<Signal<T>> createSignal(const SignalKey<T>& key, std::shared_ptr<WebSocketServer> webSocketServer, BinaryEncoder<typename SignalKey<T>::ValueType> encoder);
+
+    // Resolve once and keep the returned pointer, hot paths should never go back through the name map. Every
+    // signal of a key's name was created with the key's type, so no type check is left for runtime.
+    template<typename T>
+    std::shared_ptr<Signal<T>> getSignal(const SignalKey<T>& key);
+
+    // Stores every value of the batch before notifying any subscriber, so a callback of one signal that reads
+    // another signal of the batch sees the same batch, unless a later commit already replaced it. Each changed
+    // signal then notifies its subscribers once and the websocket messages go out as one frame per session.
+    // Only storing is serialized against other commits, a plain getValue from another thread may still see a
+    // batch half stored. Returns the number of changed signals and leaves the batch empty for reuse.
+    size_t commit(SignalBatch& batch, void* arg = nullptr);
+
+    std::vector<SignalStatsEntry> getStats();
+    // Logs a table of every signal's counters, most expensive first.
+    void dumpStats();
+
     SignalName* getSignalByName(const std::string& name);
     std::shared_ptr<SignalName> getSharedSignalByName(const std::string& name);
 
@@ -145,8 +470,14 @@ private:
     SignalManager(const SignalManager&) = delete;
     SignalManager& operator=(const SignalManager&) = delete;
 
+    // Throws when a key declares name with a value type other than T.
+    template<typename T>
+    void checkKeyType(const std::string& name) const;
+
     std::unordered_map<std::string, std::shared_ptr<SignalName>> signals_;
     std::mutex signal_mutex_;
+    // Held only while a batch's snapshots are stored, never while subscribers run.
+    std::mutex batch_mutex_;
     std::shared_ptr<spdlog::logger> logger_;
 };
 
@@ -4,6 +4,7 @@
 #include <sstream>
 #include <memory>
 #include <mutex>
+#include <atomic>
 #include <iostream>
 #include <stdexcept>
 
@@ -11,34 +12,74 @@
 template<typename T>
 T SignalValue<T>::getValue() const
 {
-    std::lock_guard<std::mutex> lock(dataMutex_);
     this->logger_->debug("GetValue");
-    if (!data_)
+    std::shared_ptr<const T> snapshot = std::atomic_load(&data_);
+    if (!snapshot)
     {
         this->logger_->error("Data is not initialized!");
         return T();
     }
-    return *data_;
+    return *snapshot;
 }
 
 template<typename T>
 bool SignalValue<T>::setValue(const T& value, void* arg)
 {
-    std::lock_guard<std::mutex> lock(dataMutex_);
-    if (!data_)
+    return publish(value, nullptr);
+}
+
+template<typename T>
+bool SignalValue<T>::setVersionedValue(const T& value, uint64_t version, void* arg)
+{
+    return publish(value, &version);
+}
+
+template<typename T>
+bool SignalValue<T>::publish(const T& value, const uint64_t* version, std::shared_ptr<const T> snapshot)
+{
+    std::shared_ptr<const T> current = std::atomic_load(&data_);
+    if (!current)
     {
         this->logger_->error("Data is not initialized!");
         return false;
     }
 
-    if (*data_ != value)
+    ChangeDetection changeDetection = changeDetection_.load(std::memory_order_relaxed);
+    if (changeDetection == ChangeDetection::ProducerVersion && version)
+    {
+        if (lastVersion_.exchange(*version) == *version)
+        {
+            this->logger_->debug("SetValue - version unchanged");
+            return false;
+        }
+        changeDetection = ChangeDetection::AlwaysPublish;
+    }
+
+    if (changeDetection == ChangeDetection::AlwaysPublish)
     {
-        *data_ = value;
-        this->logger_->debug("SetValue - value changed");
+        std::atomic_store(&data_, snapshot ? std::move(snapshot) : std::make_shared<const T>(value));
+        this->logger_->debug("SetValue - value published");
         return true;
     }
-    this->logger_->debug("SetValue - value unchanged");
-    return false;
+
+    // CompareValue, and ProducerVersion when the producer gave no version (e.g. a value set from JSON)
+    std::shared_ptr<const T> next = std::move(snapshot);
+    do
+    {
+        if (*current == value)
+        {
+            this->logger_->debug("SetValue - value unchanged");
+            return false;
+        }
+        if (!next)
+        {
+            next = std::make_shared<const T>(value);
+        }
+        // On failure current is reloaded, so a concurrent writer that already published this value wins.
+    } while (!std::atomic_compare_exchange_strong(&data_, &current, next));
+
+    this->logger_->debug("SetValue - value changed");
+    return true;
 }
 
 template<typename T>
@@ -58,39 +99,138 @@ bool SignalValue<T>::setValueFromJSON(const json& j)
 }
 
 template<typename T>
-void SignalValue<T>::registerSignalValueCallback(SignalValueCallback cb, void* arg)
+void SignalValue<T>::registerSignalValueCallback( SignalValueCallback cb
+                                                , void* arg
+                                                , CallbackDispatch dispatch
+                                                , const std::string& executorName )
+{
+    typename SignalValue<T>::SignalValueCallbackData data{cb, arg, dispatch, nullptr, nullptr};
+    if (dispatch != CallbackDispatch::Inline)
+    {
+        data.executor = SignalExecutor::get(executorName);
+        data.delivery = std::make_shared<CallbackDelivery>();
+        data.delivery->callback = std::move(cb);
+        data.delivery->arg = arg;
+    }
+    addCallback(std::move(data));
+}
+
+template<typename T>
+void SignalValue<T>::registerPublishedValueCallback( PublishedValueCallback cb
+                                                   , void* arg
+                                                   , const std::string& executorName
+                                                   , std::function<void()> dropped )
 {
-    std::lock_guard<std::mutex> lock(callbackMutex_);
-    this->logger_->debug("Register Callback");
+    // The wrapper only runs if the value is ever delivered Inline, it cannot know the publish time.
+    typename SignalValue<T>::SignalValueCallbackData data{[cb](const T& value, void* cbArg) { cb(value, cbArg, std::chrono::steady_clock::now()); }
+                                                         , arg, CallbackDispatch::Queued, nullptr, nullptr};
+    data.executor = SignalExecutor::get(executorName);
+    data.delivery = std::make_shared<CallbackDelivery>();
+    data.delivery->callback = data.callback;
+    data.delivery->publishedCallback = std::move(cb);
+    data.delivery->dropped = std::move(dropped);
+    data.delivery->arg = arg;
+    addCallback(std::move(data));
+}
+
+template<typename T>
+void SignalValue<T>::addCallback(SignalValueCallbackData data)
+{
+    data.stats = std::make_shared<CallbackStats>();
+
+    std::shared_ptr<CallbackDelivery> retired;
+    {
+        std::lock_guard<std::mutex> lock(callbackMutex_);
+        this->logger_->debug("Register Callback");
+
+        auto callbacks = std::make_shared<std::vector<typename SignalValue<T>::SignalValueCallbackData>>(*this->callbacks_);
+        auto it = std::find_if(callbacks->begin(), callbacks->end(),
+            [arg = data.arg](const typename SignalValue<T>::SignalValueCallbackData& existing) { return existing.arg == arg; });
+
+        if (it != callbacks->end())
+        {
+            this->logger_->info("Existing Callback Updated.");
+            retired = it->delivery;
+            *it = std::move(data);
+        }
+        else
+        {
+            this->logger_->info("New Callback Registered.");
+            callbacks->emplace_back(std::move(data));
+        }
+        std::atomic_store(&this->callbacks_, std::shared_ptr<const std::vector<typename SignalValue<T>::SignalValueCallbackData>>(std::move(callbacks)));
+    }
+    retireDelivery(retired);
+}
 
-    auto it = std::find_if(this->callbacks_.begin(), this->callbacks_.end(),
-        [arg](const typename SignalValue<T>::SignalValueCallbackData& data) { return data.arg == arg; });
+template<typename T>
+void SignalValue<T>::unregisterSignalValueCallbackByArg(void* arg)
+{
+    std::vector<std::shared_ptr<CallbackDelivery>> retired;
+    {
+        std::lock_guard<std::mutex> lock(callbackMutex_);
+        this->logger_->debug("Callback Unregistered.");
 
-    if (it != this->callbacks_.end())
+        auto callbacks = std::make_shared<std::vector<typename SignalValue<T>::SignalValueCallbackData>>();
+        for (const auto& data : *this->callbacks_)
+        {
+            if (data.arg == arg)
+            {
+                retired.push_back(data.delivery);
+            }
+            else
+            {
+                callbacks->push_back(data);
+            }
+        }
+        std::atomic_store(&this->callbacks_, std::shared_ptr<const std::vector<typename SignalValue<T>::SignalValueCallbackData>>(std::move(callbacks)));
+    }
+    // Outside callbackMutex_, a running callback may publish to this signal.
+    for (const auto& delivery : retired)
     {
-        this->logger_->info("Existing Callback Updated.");
-        it->callback = std::move(cb);
+        retireDelivery(delivery);
     }
-    else
+}
+
+template<typename T>
+SignalStatsEntry SignalValue<T>::getStats() const
+{
+    SignalStatsEntry entry = this->stats_.snapshot(this->name_);
+    auto callbacks = std::atomic_load(&this->callbacks_);
+    for (const auto& subscriber : *callbacks)
     {
-        this->logger_->info("New Callback Registered.");
-        this->callbacks_.emplace_back(typename SignalValue<T>::SignalValueCallbackData{std::move(cb), arg});
+        std::ostringstream label;
+        switch (subscriber.dispatch)
+        {
+            case CallbackDispatch::Inline:      label << "Inline"; break;
+            case CallbackDispatch::Queued:      label << "Queued on " << subscriber.executor->getName(); break;
+            case CallbackDispatch::LatestValue: label << "Latest Value on " << subscriber.executor->getName(); break;
+        }
+        label << " (" << subscriber.arg << ")";
+        if (subscriber.stats)
+        {
+            entry.subscribers.push_back(subscriber.stats->snapshot(label.str()));
+        }
     }
+    return entry;
 }
 
 template<typename T>
-void SignalValue<T>::unregisterSignalValueCallbackByArg(void* arg)
+void SignalValue<T>::retireDelivery(const std::shared_ptr<CallbackDelivery>& delivery)
 {
-    std::lock_guard<std::mutex> lock(callbackMutex_);
-    this->logger_->debug("Callback Unregistered.");
-    this->callbacks_.erase(std::remove_if(this->callbacks_.begin(), this->callbacks_.end(),
-        [arg](const typename SignalValue<T>::SignalValueCallbackData& data) { return data.arg == arg; }), this->callbacks_.end());
+    if (!delivery)
+    {
+        return;
+    }
+    // Waits for a callback already running on the executor, queued deliveries then see it inactive.
+    std::lock_guard<std::mutex> lock(delivery->runMutex);
+    delivery->active = false;
 }
 
 template<typename T>
 Signal<T>::Signal( const std::string& name )
                  : SignalValue<T>(name)
-                 , webSocketServer_(nullptr)
+                 , webSocketServer_()
                  , jsonEncoder_(nullptr)
                  , binaryEncoder_(nullptr)
                  , isUsingWebSocket_(false)
@@ -142,6 +282,7 @@ void Signal<T>::setup()
     if (server)
     {
         server->register_notification_client(this->getName(), this);
+        webSocketSubscriberCount_ = server->get_subscriber_count(this->getName());
     }
     else
     {
@@ -152,7 +293,19 @@ void Signal<T>::setup()
 template<typename T>
 bool Signal<T>::setValue(const T& value, void* arg)
 {
-    bool valueChanged = SignalValue<T>::setValue(value, arg);
+    bool valueChanged = storeValue(value, nullptr);
+    if(valueChanged)
+    {
+        notifyClients(arg);
+        notifyWebSocket();
+    }
+    return valueChanged;
+}
+
+template<typename T>
+bool Signal<T>::setVersionedValue(const T& value, uint64_t version, void* arg)
+{
+    bool valueChanged = storeValue(value, &version);
     if(valueChanged)
     {
         notifyClients(arg);
@@ -161,48 +314,250 @@ bool Signal<T>::setValue(const T& value, void* arg)
     return valueChanged;
 }
 
+template<typename T>
+bool Signal<T>::storeValue(const T& value, const uint64_t* version, std::shared_ptr<const T> snapshot)
+{
+    SignalStatsTimer timer;
+    bool valueChanged = this->publish(value, version, std::move(snapshot));
+    this->stats_.recordSet(valueChanged, timer.elapsedNs());
+    if(valueChanged)
+    {
+        std::atomic_store(&encodedValue_, std::shared_ptr<const EncodedValue>());
+        recordHistory();
+    }
+    return valueChanged;
+}
+
 template<typename T>
 bool Signal<T>::notifyClients(void* arg) const
 {
     this->logger_->debug("NotifyClients.");
 
-    if (this->callbacks_.empty())
+    auto callbacks = std::atomic_load(&this->callbacks_);
+    if (callbacks->empty())
     {
         this->logger_->debug("No callbacks registered.");
         return false;
     }
 
-    if (!this->data_)
+    std::shared_ptr<const T> snapshot = std::atomic_load(&this->data_);
+    if (!snapshot)
     {
         this->logger_->error("{}: Data is not initialized.", this->name_);
         return false;
     }
 
-    for (const auto& aCallback : this->callbacks_)
+    for (const auto& aCallback : *callbacks)
     {
-        if (aCallback.callback)
+        if (!aCallback.callback)
         {
-            aCallback.callback(*this->data_, aCallback.arg);
+            this->logger_->warn("Found a null callback.");
+            continue;
         }
-        else
+
+        switch (aCallback.dispatch)
         {
-            this->logger_->warn("Found a null callback.");
+            case CallbackDispatch::Inline:
+            {
+                SignalStatsTimer timer;
+                aCallback.callback(*snapshot, aCallback.arg);
+                aCallback.stats->record(timer.elapsedNs());
+                break;
+            }
+
+            case CallbackDispatch::Queued:
+                // The snapshot is immutable, so the executor can read it after the next publish replaced it.
+                if (!aCallback.executor->post([delivery = aCallback.delivery, stats = aCallback.stats, snapshot, publishedAt = std::chrono::steady_clock::now()]()
+                {
+                    std::lock_guard<std::mutex> lock(delivery->runMutex);
+                    if (delivery->active)
+                    {
+                        SignalStatsTimer timer;
+                        if (delivery->publishedCallback)
+                        {
+                            delivery->publishedCallback(*snapshot, delivery->arg, publishedAt);
+                        }
+                        else
+                        {
+                            delivery->callback(*snapshot, delivery->arg);
+                        }
+                        stats->record(timer.elapsedNs());
+                    }
+                }) && aCallback.delivery->dropped)
+                {
+                    aCallback.delivery->dropped();
+                }
+                break;
+
+            case CallbackDispatch::LatestValue:
+                postLatestValue(aCallback, snapshot);
+                break;
         }
     }
     return true;
 }
 
+template<typename T>
+void Signal<T>::postLatestValue(const typename SignalValue<T>::SignalValueCallbackData& subscriber, const std::shared_ptr<const T>& snapshot) const
+{
+    auto delivery = subscriber.delivery;
+    {
+        std::lock_guard<std::mutex> lock(delivery->pendingMutex);
+        delivery->pending = snapshot;
+        if (delivery->posted)
+        {
+            // The queued delivery picks up this snapshot instead.
+            return;
+        }
+        delivery->posted = true;
+    }
+
+    bool posted = subscriber.executor->post([delivery, stats = subscriber.stats]()
+    {
+        std::shared_ptr<const T> value;
+        {
+            std::lock_guard<std::mutex> lock(delivery->pendingMutex);
+            value = std::move(delivery->pending);
+            delivery->posted = false;
+        }
+        std::lock_guard<std::mutex> lock(delivery->runMutex);
+        if (delivery->active && value)
+        {
+            SignalStatsTimer timer;
+            delivery->callback(*value, delivery->arg);
+            stats->record(timer.elapsedNs());
+        }
+    });
+
+    if (!posted)
+    {
+        std::lock_guard<std::mutex> lock(delivery->pendingMutex);
+        delivery->posted = false;
+    }
+}
+
 template<typename T>
 bool Signal<T>::notifyWebSocket() const
+{
+    return webSocketSendDue() && sendToWebSocket();
+}
+
+// True when the current value should be sent now. Inside the rate limit interval a trailing publish is
+// scheduled instead.
+template<typename T>
+bool Signal<T>::webSocketSendDue() const
 {
     if (!isUsingWebSocket_) 
         return false;
 
-    if (!this->data_)
+    // Nobody is watching, skip the encode and the broadcast entirely.
+    if (!hasWebSocketSubscribers())
+        return false;
+
+    if (webSocketMaxRate_.load(std::memory_order_relaxed) <= 0.0f)
     {
-        this->logger_->error("{}: Data is not initialized.", this->name_);
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(webSocketRateMutex_);
+    const auto now = std::chrono::steady_clock::now();
+    if (now < nextWebSocketPublish_)
+    {
+        // Inside the interval, the trailing publish encodes whatever value is latest when it fires.
+        this->stats_.recordWebSocketConflated();
+        if (!webSocketTrailingPending_)
+        {
+            scheduleTrailingWebSocketPublish();
+        }
         return false;
     }
+    nextWebSocketPublish_ = now + webSocketInterval();
+    return true;
+}
+
+template<typename T>
+std::shared_ptr<WebSocketMessage> Signal<T>::takeBatchWebSocketMessage() const
+{
+    if (!webSocketSendDue())
+    {
+        return nullptr;
+    }
+    auto wsMsg = getWebSocketValueMessage();
+    if (wsMsg)
+    {
+        this->stats_.recordWebSocketSend();
+    }
+    return wsMsg;
+}
+
+template<typename T>
+std::chrono::steady_clock::duration Signal<T>::webSocketInterval() const
+{
+    const float maxRate = webSocketMaxRate_.load(std::memory_order_relaxed);
+    if (maxRate <= 0.0f)
+    {
+        return std::chrono::steady_clock::duration::zero();
+    }
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(1.0f / maxRate));
+}
+
+// Called with webSocketRateMutex_ held.
+template<typename T>
+void Signal<T>::scheduleTrailingWebSocketPublish() const
+{
+    auto server = webSocketServer_.lock();
+    std::weak_ptr<const Signal<T>> weakSelf = this->weak_from_this();
+    if (!server || weakSelf.expired())
+    {
+        this->logger_->debug("{}: Cannot schedule a trailing publish, dropping rate limited value.", this->name_);
+        return;
+    }
+
+    if (!webSocketStrand_)
+    {
+        webSocketStrand_ = std::make_unique<net::strand<net::io_context::executor_type>>(net::make_strand(server->get_io_context()));
+    }
+    webSocketTrailingPending_ = true;
+    // Armed on the strand, the producer never touches the timer. Pending is only cleared by the wait handler,
+    // so at most one arm is in flight.
+    net::post(*webSocketStrand_, [weakSelf, publishAt = nextWebSocketPublish_]()
+    {
+        auto self = weakSelf.lock();
+        if (!self)
+        {
+            return;
+        }
+        if (!self->webSocketTimer_)
+        {
+            self->webSocketTimer_ = std::make_unique<net::steady_timer>(*self->webSocketStrand_);
+        }
+        self->webSocketTimer_->expires_at(publishAt);
+        self->webSocketTimer_->async_wait([weakSelf](const boost::system::error_code& ec)
+        {
+            if (ec)
+            {
+                return;
+            }
+            auto self = weakSelf.lock();
+            if (!self)
+            {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(self->webSocketRateMutex_);
+                self->webSocketTrailingPending_ = false;
+                self->nextWebSocketPublish_ = std::chrono::steady_clock::now() + self->webSocketInterval();
+            }
+            self->sendToWebSocket();
+        });
+    });
+}
+
+template<typename T>
+bool Signal<T>::sendToWebSocket() const
+{
+    if (!isUsingWebSocket_ || !hasWebSocketSubscribers()) 
+        return false;
 
     auto server = webSocketServer_.lock();
     if (!server)
@@ -211,90 +566,336 @@ bool Signal<T>::notifyWebSocket() const
         return false;
     }
 
-    if (!jsonEncoder_ && !binaryEncoder_)
+    auto wsMsg = getWebSocketValueMessage();
+    if (!wsMsg)
     {
-        this->logger_->error("{}: No encoder provided.", this->name_);
         return false;
     }
+    server->broadcast_signal_to_websocket(this->name_, std::move(wsMsg));
+    this->stats_.recordWebSocketSend();
+    return true;
+}
+
+template<typename T>
+std::shared_ptr<WebSocketMessage> Signal<T>::getWebSocketValueMessage() const
+{
+    if (!isUsingWebSocket_)
+        return nullptr;
 
-    std::shared_ptr<T> dataCopy;
+    std::shared_ptr<const T> dataCopy = std::atomic_load(&this->data_);
+    if (!dataCopy)
     {
-        std::lock_guard<std::mutex> lock(this->dataMutex_);
-        dataCopy = this->data_;
+        this->logger_->error("{}: Data is not initialized.", this->name_);
+        return nullptr;
     }
 
-    if (!dataCopy) return false;
+    // A publish swaps in a new snapshot, so a cache entry for an older snapshot is stale by construction.
+    std::shared_ptr<const EncodedValue> cached = std::atomic_load(&encodedValue_);
+    if (cached && cached->value == dataCopy)
+    {
+        this->logger_->debug("{}: Using cached websocket message.", this->name_);
+        return cached->message;
+    }
+
+    if (!jsonEncoder_ && !binaryEncoder_)
+    {
+        this->logger_->error("{}: No encoder provided.", this->name_);
+        return nullptr;
+    }
 
     // Protect to_string from crashing
     try
     {
-        this->logger_->debug("NotifyWebSocket: {}", to_string(*dataCopy));
+        if (this->logger_->should_log(spdlog::level::debug))
+        {
+            this->logger_->debug("NotifyWebSocket: {}", to_string(*dataCopy));
+        }
     }
     catch (const std::exception& e)
     {
         this->logger_->warn("{}: Exception in to_string: {}", this->name_, e.what());
-        return false;
+        return nullptr;
     }
     catch (...)
     {
         this->logger_->warn("{}: Unknown exception in to_string", this->name_);
-        return false;
+        return nullptr;
     }
 
+    std::shared_ptr<WebSocketMessage> wsMsg = encodeWebSocketMessage(*dataCopy);
+    if (!wsMsg)
+    {
+        return nullptr;
+    }
+
+    std::atomic_store(&encodedValue_, std::make_shared<const EncodedValue>(EncodedValue{dataCopy, wsMsg}));
+    return wsMsg;
+}
+
+template<typename T>
+std::shared_ptr<WebSocketMessage> Signal<T>::encodeWebSocketMessage(const T& value, bool recordStats) const
+{
+    SignalStatsTimer timer;
+    std::shared_ptr<WebSocketMessage> wsMsg;
     // JSON Encoder
     if (jsonEncoder_)
     {
         try
         {
-            auto msg = jsonEncoder_(this->name_, *dataCopy);
-            auto wsMsg = std::make_shared<WebSocketMessage>(msg, priority_, should_retry_);
-            server->broadcast_signal_to_websocket(this->name_, std::move(wsMsg));
+            auto msg = jsonEncoder_(this->name_, value);
+            wsMsg = std::make_shared<WebSocketMessage>(msg, priority_, should_retry_);
         }
         catch (const std::exception& e)
         {
             this->logger_->error("{}: Exception in jsonEncoder: {}", this->name_, e.what());
-            return false;
+            return nullptr;
         }
         catch (...)
         {
             this->logger_->error("{}: Unknown exception in jsonEncoder", this->name_);
-            return false;
+            return nullptr;
         }
     }
     else if (binaryEncoder_)
     {
         try
         {
-            auto msg = binaryEncoder_(this->name_, *dataCopy);
-            if (!msg.empty())
+            // Encoded straight into a pooled buffer that the message then owns. The message is cached until the
+            // next publish, so an oversized buffer is trimmed rather than held.
+            std::vector<uint8_t> buffer = BinaryBufferPool::getInstance().acquire();
+            binaryEncoder_(this->name_, value, buffer);
+            if (!buffer.empty())
             {
-                auto wsMsg = std::make_shared<WebSocketMessage>(msg, priority_, should_retry_);
-                server->broadcast_signal_to_websocket(this->name_, std::move(wsMsg));
+                BinaryBufferPool::getInstance().trim(buffer);
+                wsMsg = std::make_shared<WebSocketMessage>(std::move(buffer), priority_, should_retry_);
             }
             else
             {
+                BinaryBufferPool::getInstance().release(std::move(buffer));
                 this->logger_->warn("{}: Binary encoder returned empty message, not sending.", this->name_);
-                return false;
+                return nullptr;
             }
         }
         catch (const std::exception& e)
         {
             this->logger_->error("{}: Exception in binaryEncoder: {}", this->name_, e.what());
-            return false;
+            return nullptr;
         }
         catch (...)
         {
             this->logger_->error("{}: Unknown exception in binaryEncoder", this->name_);
-            return false;
+            return nullptr;
         }
     }
+
+    if (wsMsg && recordStats)
+    {
+        const bool binary = wsMsg->webSocket_Message_type == WebSocketMessageType::Binary;
+        this->stats_.recordEncode(timer.elapsedNs(), binary ? wsMsg->binary_data.size() : wsMsg->message.size());
+    }
+    return wsMsg;
+}
+
+template<typename T>
+bool Signal<T>::registerEncodedValueCallback(typename SignalName::EncodedValueCallback cb, void* arg, const std::string& executorName, std::function<void()> dropped)
+{
+    if (!isUsingWebSocket_ || (!jsonEncoder_ && !binaryEncoder_))
+    {
+        this->logger_->warn("{}: No encoder, cannot deliver encoded values.", this->name_);
+        return false;
+    }
+    // Encoding runs on the executor, the producer only posts the snapshot and its publish time.
+    this->registerPublishedValueCallback([this, cb = std::move(cb)](const T& value, void*, std::chrono::steady_clock::time_point publishedAt)
+    {
+        auto message = encodeWebSocketMessage(value);
+        if (message)
+        {
+            cb(message, publishedAt);
+        }
+    }, arg, executorName, std::move(dropped));
     return true;
 }
 
+template<typename T>
+bool Signal<T>::setValueFromBinary(const uint8_t* data, size_t size)
+{
+    if (!binaryDecoder_)
+    {
+        this->logger_->debug("{}: No binary decoder.", this->name_);
+        return false;
+    }
+    T value;
+    if (!binaryDecoder_(data, size, value))
+    {
+        this->logger_->warn("{}: Malformed binary message of {} bytes.", this->name_, size);
+        return false;
+    }
+    setValue(value, nullptr);
+    return true;
+}
+
+template<typename T>
+void Signal<T>::enableHistory(size_t capacity)
+{
+    std::vector<HistoryEntry> released;
+    {
+        std::lock_guard<std::mutex> lock(historyMutex_);
+        released.swap(history_);
+        history_.resize(capacity);
+        historyNext_ = 0;
+        historySize_ = 0;
+        historyCapacity_.store(capacity);
+    }
+    this->logger_->info("{}: History capacity set to {}.", this->name_, capacity);
+}
+
+template<typename T>
+void Signal<T>::recordHistory()
+{
+    if (historyCapacity_.load(std::memory_order_relaxed) == 0)
+    {
+        return;
+    }
+
+    HistoryEntry entry{binary_timestamp_ms(), std::atomic_load(&this->data_)};
+    {
+        std::lock_guard<std::mutex> lock(historyMutex_);
+        if (history_.empty())
+        {
+            return;
+        }
+        // The evicted snapshot is swapped out and released after the lock, a large value never frees under it.
+        std::swap(history_[historyNext_], entry);
+        historyNext_ = (historyNext_ + 1) % history_.size();
+        historySize_ = std::min(historySize_ + 1, history_.size());
+    }
+}
+
+template<typename T>
+std::shared_ptr<WebSocketMessage> Signal<T>::getWebSocketHistoryMessage(const SignalHistoryQuery& query) const
+{
+    if (!isUsingWebSocket_ || historyCapacity_.load() == 0)
+    {
+        return nullptr;
+    }
+
+    std::vector<std::pair<size_t, HistoryEntry>> entries;     // Ring slot and a copy of its entry
+    {
+        std::lock_guard<std::mutex> lock(historyMutex_);
+        entries.reserve(historySize_);
+        const size_t oldest = (historyNext_ + history_.size() - historySize_) % std::max<size_t>(1, history_.size());
+        for (size_t i = 0; i < historySize_; ++i)
+        {
+            const size_t slot = (oldest + i) % history_.size();
+            const HistoryEntry& entry = history_[slot];
+            if (entry.timestampMs >= query.fromMs && entry.timestampMs <= query.toMs)
+            {
+                entries.emplace_back(slot, entry);
+            }
+        }
+    }
+    if (query.last > 0 && entries.size() > query.last)
+    {
+        entries.erase(entries.begin(), entries.end() - query.last);
+    }
+
+    // Only entries no earlier request encoded are encoded, outside the lock so the producer keeps recording.
+    // The newest entry is usually the cached value.
+    std::shared_ptr<const EncodedValue> cached = std::atomic_load(&encodedValue_);
+    std::vector<std::pair<size_t, HistoryEntry>> newlyEncoded;
+    size_t size = BinaryWriter::headerSize(this->name_) + 4;
+    for (auto& [slot, entry] : entries)
+    {
+        if (!entry.message)
+        {
+            entry.message = cached && cached->value == entry.value ? cached->message : encodeWebSocketMessage(*entry.value, false);
+            if (!entry.message)
+            {
+                continue;
+            }
+            newlyEncoded.emplace_back(slot, entry);
+        }
+        const WebSocketMessage& message = *entry.message;
+        const size_t length = message.webSocket_Message_type == WebSocketMessageType::Binary ? message.binary_data.size() : message.message.size();
+        size += 8 + 1 + 4 + length;
+    }
+    if (!newlyEncoded.empty())
+    {
+        // Kept in the ring for the next request, unless the slot was overwritten meanwhile.
+        std::lock_guard<std::mutex> lock(historyMutex_);
+        for (const auto& [slot, entry] : newlyEncoded)
+        {
+            if (slot < history_.size() && history_[slot].value == entry.value && !history_[slot].message)
+            {
+                history_[slot].message = entry.message;
+            }
+        }
+    }
+
+    std::vector<uint8_t> buffer = BinaryBufferPool::getInstance().acquire();
+    BinaryWriter writer(buffer, size);
+    writer.header(BinaryEncoderType::Signal_History_Encoder, this->name_);
+    const size_t count = std::count_if(entries.begin(), entries.end(), [](const auto& slotEntry) { return slotEntry.second.message != nullptr; });
+    writer.u32(static_cast<uint32_t>(count));
+    for (const auto& [slot, entry] : entries)
+    {
+        const std::shared_ptr<WebSocketMessage>& message = entry.message;
+        if (!message)
+        {
+            continue;
+        }
+        const bool binary = message->webSocket_Message_type == WebSocketMessageType::Binary;
+        writer.u64(entry.timestampMs);
+        writer.u8(binary ? 1 : 0);
+        if (binary)
+        {
+            writer.u32(static_cast<uint32_t>(message->binary_data.size()));
+            writer.bytes(message->binary_data.data(), message->binary_data.size());
+        }
+        else
+        {
+            writer.u32(static_cast<uint32_t>(message->message.size()));
+            writer.bytes(message->message.data(), message->message.size());
+        }
+    }
+    return std::make_shared<WebSocketMessage>(std::move(buffer), priority_, should_retry_);
+}
+
+template<typename T>
+SignalBatch& SignalBatch::set(const std::shared_ptr<Signal<T>>& signal, T value)
+{
+    if (signal)
+    {
+        stage(Entry{signal, std::make_shared<const T>(std::move(value))});
+    }
+    return *this;
+}
+
+template<typename T>
+SignalBatch& SignalBatch::setVersioned(const std::shared_ptr<Signal<T>>& signal, T value, uint64_t version)
+{
+    if (signal)
+    {
+        stage(Entry{signal, std::make_shared<const T>(std::move(value)), true, version});
+    }
+    return *this;
+}
+
+template<typename T>
+void SignalManager::checkKeyType(const std::string& name) const
+{
+    const std::type_index* declared = findSignalKeyType(name);
+    if (declared && *declared != std::type_index(typeid(T)))
+    {
+        throw std::runtime_error("Signal \"" + name + "\" is declared with another value type");
+    }
+}
+
 template<typename T>
 std::shared_ptr<Signal<T>> SignalManager::createSignal(const std::string& name)
 {
     std::lock_guard<std::mutex> lock(signal_mutex_);
+    checkKeyType<T>(name);
     auto it = signals_.find(name);
     if (it != signals_.end())
     {
@@ -317,6 +918,7 @@ std::shared_ptr<Signal<T>> SignalManager::createSignal(const std::string& name,
                                                        JsonEncoder<T> encoder)
 {
     std::lock_guard<std::mutex> lock(signal_mutex_);
+    checkKeyType<T>(name);
     auto it = signals_.find(name);
     if (it != signals_.end())
     {
@@ -338,6 +940,7 @@ template<typename T>
 std::shared_ptr<Signal<T>> SignalManager::createSignal(const std::string& name, std::shared_ptr<WebSocketServer> webSocketServer, BinaryEncoder<T> encoder)
 {
     std::lock_guard<std::mutex> lock(signal_mutex_);
+    checkKeyType<T>(name);
     auto it = signals_.find(name);
     if (it != signals_.end())
     {
@@ -355,3 +958,36 @@ std::shared_ptr<Signal<T>> SignalManager::createSignal(const std::string& name,
     return signal;
 }
 
+template<typename T>
+std::shared_ptr<Signal<T>> SignalManager::createSignal(const SignalKey<T>& key)
+{
+    return createSignal<T>(std::string(key.name));
+}
+
+template<typename T>
+std::shared_ptr<Signal<T>> SignalManager::createSignal(const SignalKey<T>& key,
+                                                       std::shared_ptr<WebSocketServer> webSocketServer,
+                                                       JsonEncoder<typename SignalKey<T>::ValueType> encoder)
+{
+    return createSignal<T>(std::string(key.name), webSocketServer, encoder);
+}
+
+template<typename T>
+std::shared_ptr<Signal<T>> SignalManager::createSignal(const SignalKey<T>& key,
+                                                       std::shared_ptr<WebSocketServer> webSocketServer,
+                                                       BinaryEncoder<typename SignalKey<T>::ValueType> encoder)
+{
+    return createSignal<T>(std::string(key.name), webSocketServer, encoder);
+}
+
+template<typename T>
+std::shared_ptr<Signal<T>> SignalManager::getSignal(const SignalKey<T>& key)
+{
+    std::shared_ptr<SignalName> signal = getSharedSignalByName(key.name);
+    if (!signal)
+    {
+        logger_->warn("Signal \"{}\" has not been created.", key.name);
+        return nullptr;
+    }
+    return std::static_pointer_cast<Signal<T>>(signal);
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <cmath>
+#include <algorithm>
+#include "logger.h"
+#include "stereo_capture_listener.h"
+#include "signals/SignalKeys.h"
+#include "websocket_server.h"
+
+// Goniometer data for the stereo capture: correlation, balance and a decimated mid/side point cloud per block.
+class StereoAnalyzer : public StereoCaptureListener
+{
+    public:
+        StereoAnalyzer( const std::string name
+                      , const std::string input_signal_name
+                      , const std::string output_signal_name
+                      , std::shared_ptr<WebSocketServer> webSocketServer )
+            : StereoCaptureListener(name, input_signal_name, initializeLogger("Stereo Analyzer", spdlog::level::info))
+            , name_(name)
+            , output_signal_name_(output_signal_name)
+            , webSocketServer_(webSocketServer)
+            , logger_(initializeLogger("Stereo Analyzer", spdlog::level::info))
+        {
+            // Every capture block is a fresh point cloud, comparing it to the last one would never skip a publish.
+            outputSignal_->setChangeDetection(ChangeDetection::AlwaysPublish);
+            outputSignal_->setWebSocketMaxRate(WEBSOCKET_DISPLAY_RATE_HZ);
+
+            pointBudgetSignalCallback_ = [](const uint32_t& value, void* arg)
+            {
+                StereoAnalyzer* self = static_cast<StereoAnalyzer*>(arg);
+                self->pointBudget_ = std::min<size_t>(value, MAX_POINT_BUDGET);
+                self->logger_->info("Stereo Analyzer: Received new Stereo Point Budget: {}", self->pointBudget_.load());
+            };
+
+            pointBudgetSignal_ = SignalManager::getInstance().getSignal(SignalKeys::StereoPointBudget);
+            if (pointBudgetSignal_)
+            {
+                pointBudgetSignal_->setValue(static_cast<uint32_t>(pointBudget_.load()));
+                pointBudgetSignal_->registerSignalValueCallback(pointBudgetSignalCallback_, this);
+            }
+            else
+            {
+                logger_->warn("Stereo Analyzer: Stereo Point Budget signal not found, using default value: {}", pointBudget_.load());
+            }
+
+            startListening();
+        }
+
+        ~StereoAnalyzer()
+        {
+            stopListening();
+            if (pointBudgetSignal_) pointBudgetSignal_->unregisterSignalValueCallbackByArg(this);
+        }
+
+    protected:
+        void onStereoPacket(const std::vector<int32_t>& left, const std::vector<int32_t>& right) override
+        {
+            const size_t count = left.size();
+            if (count == 0) return;
+
+            double sumLL = 0.0;
+            double sumRR = 0.0;
+            double sumLR = 0.0;
+            int64_t peak = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                const double l = left[i];
+                const double r = right[i];
+                sumLL += l * l;
+                sumRR += r * r;
+                sumLR += l * r;
+                peak = std::max<int64_t>(peak, std::max(std::abs(static_cast<int64_t>(left[i])), std::abs(static_cast<int64_t>(right[i]))));
+            }
+
+            field_.correlation = (sumLL > 0.0 && sumRR > 0.0) ? static_cast<float>(sumLR / std::sqrt(sumLL * sumRR)) : 0.0f;
+            const double rmsLeft = std::sqrt(sumLL / count);
+            const double rmsRight = std::sqrt(sumRR / count);
+            field_.balance = (rmsLeft + rmsRight) > 0.0 ? static_cast<float>((rmsRight - rmsLeft) / (rmsRight + rmsLeft)) : 0.0f;
+
+            // Evenly strided samples rotated 45 degrees to side/mid, scaled by the block's peak so quiet passages stay readable.
+            const size_t budget = std::min(pointBudget_.load(), count);
+            field_.points.resize(budget);
+            if (budget > 0)
+            {
+                // Halved so a full scale mono or out of phase sample lands exactly on the edge.
+                const float scale = peak > 0 ? static_cast<float>(0.5 / static_cast<double>(peak)) : 0.0f;
+                const double stride = static_cast<double>(count) / budget;
+                for (size_t p = 0; p < budget; ++p)
+                {
+                    const size_t i = static_cast<size_t>(p * stride);
+                    const float l = static_cast<float>(left[i]);
+                    const float r = static_cast<float>(right[i]);
+                    field_.points[p] = { (l - r) * scale, (l + r) * scale };
+                }
+            }
+            outputSignal_->setValue(field_);
+        }
+
+    private:
+        static constexpr size_t DEFAULT_POINT_BUDGET = 128;
+        static constexpr size_t MAX_POINT_BUDGET = 1024;
+
+        std::string name_;
+        std::string output_signal_name_;
+        std::shared_ptr<WebSocketServer> webSocketServer_;
+        std::shared_ptr<spdlog::logger> logger_;
+        std::atomic<size_t> pointBudget_{DEFAULT_POINT_BUDGET};
+        StereoField field_;
+
+        std::shared_ptr<Signal<StereoField>> outputSignal_ = SignalManager::getInstance().createSignal<StereoField>(output_signal_name_, webSocketServer_, get_stereo_field_encoder());
+        std::shared_ptr<Signal<uint32_t>> pointBudgetSignal_;
+        std::function<void(const uint32_t&, void*)> pointBudgetSignalCallback_;
+};
@@ -0,0 +1,84 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <functional>
+#include "logger.h"
+#include "signals/IntVectorSignal.h"
+
+// Pairs the "<input> Left Channel" and "<input> Right Channel" packets the microphone publishes back to back
+// and hands them to onStereoPacket together, for analysers that need both channels of the same capture.
+class StereoCaptureListener
+{
+    public:
+        StereoCaptureListener( const std::string& name
+                             , const std::string& input_signal_name
+                             , std::shared_ptr<spdlog::logger> logger )
+            : listenerName_(name)
+            , listenerLogger_(logger)
+            , rateLimitedListenerLog_(std::make_shared<RateLimitedLogger>(logger, std::chrono::seconds(10)))
+            , leftChannelSignal_(std::dynamic_pointer_cast<Signal<std::vector<int32_t>>>(SignalManager::getInstance().getSharedSignalByName(input_signal_name + " Left Channel")))
+            , rightChannelSignal_(std::dynamic_pointer_cast<Signal<std::vector<int32_t>>>(SignalManager::getInstance().getSharedSignalByName(input_signal_name + " Right Channel")))
+        {
+            if (!leftChannelSignal_) throw std::runtime_error("Failed to get signal: " + input_signal_name + " Left Channel");
+            if (!rightChannelSignal_) throw std::runtime_error("Failed to get signal: " + input_signal_name + " Right Channel");
+        }
+
+        virtual ~StereoCaptureListener()
+        {
+            stopListening();
+        }
+
+    protected:
+        virtual void onStereoPacket(const std::vector<int32_t>& left, const std::vector<int32_t>& right) = 0;
+
+        // Called by the derived class once it is fully constructed, and from its destructor before it is torn down.
+        // A listener may also stop and start again later, e.g. while it is switched off.
+        // Packets are queued to an executor named after the listener, so analysis never runs on the capture thread.
+        void startListening()
+        {
+            {
+                std::lock_guard<std::mutex> lock(pairMutex_);
+                hasPendingLeft_ = false;
+            }
+            leftChannelSignal_->registerSignalValueCallback([](const std::vector<int32_t>& value, void* arg)
+            {
+                StereoCaptureListener* self = static_cast<StereoCaptureListener*>(arg);
+                std::lock_guard<std::mutex> lock(self->pairMutex_);
+                self->pendingLeft_ = value;
+                self->hasPendingLeft_ = true;
+            }, this, CallbackDispatch::Queued, listenerName_);
+
+            rightChannelSignal_->registerSignalValueCallback([](const std::vector<int32_t>& value, void* arg)
+            {
+                StereoCaptureListener* self = static_cast<StereoCaptureListener*>(arg);
+                std::lock_guard<std::mutex> lock(self->pairMutex_);
+                if (!self->hasPendingLeft_ || self->pendingLeft_.size() != value.size())
+                {
+                    self->rateLimitedListenerLog_->log("unpaired", spdlog::level::warn, "Device {}: Dropping unpaired stereo packet.", self->listenerName_);
+                    self->hasPendingLeft_ = false;
+                    return;
+                }
+                self->hasPendingLeft_ = false;
+                self->onStereoPacket(self->pendingLeft_, value);
+            }, this, CallbackDispatch::Queued, listenerName_);
+            listenerLogger_->debug("Device {}: Listening for stereo packets.", listenerName_);
+        }
+
+        void stopListening()
+        {
+            leftChannelSignal_->unregisterSignalValueCallbackByArg(this);
+            rightChannelSignal_->unregisterSignalValueCallbackByArg(this);
+        }
+
+    private:
+        std::string listenerName_;
+        std::shared_ptr<spdlog::logger> listenerLogger_;
+        std::shared_ptr<RateLimitedLogger> rateLimitedListenerLog_;
+        std::shared_ptr<Signal<std::vector<int32_t>>> leftChannelSignal_;
+        std::shared_ptr<Signal<std::vector<int32_t>>> rightChannelSignal_;
+        std::mutex pairMutex_;
+        std::vector<int32_t> pendingLeft_;
+        bool hasPendingLeft_ = false;
+};
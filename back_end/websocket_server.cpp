@@ -1,4 +1,6 @@
 #include "websocket_server.h"
+#include <map>
+#include "signals/DataTypesAndEncoders/Encoder_Binary.h"
 
 
 WebSocketServer::WebSocketServer(unsigned short port, unsigned int thread_count)
@@ -246,10 +248,104 @@ void WebSocketServer::broadcast_signal_to_websocket(const std::string& signal_na
     }
 }
 
+// One Signal_Batch_Encoder frame carrying the selected messages whole, see Encoder_Binary.h.
+static std::shared_ptr<WebSocketMessage> encode_batch_message( const std::vector<std::pair<std::string, std::shared_ptr<WebSocketMessage>>>& messages
+                                                             , const std::vector<size_t>& indices )
+{
+    size_t size = BinaryWriter::headerSize("") + 4;
+    MessagePriority priority = MessagePriority::Low;
+    bool should_retry = false;
+    for (size_t index : indices)
+    {
+        const WebSocketMessage& message = *messages[index].second;
+        const bool binary = message.webSocket_Message_type == WebSocketMessageType::Binary;
+        size += 1 + 4 + (binary ? message.binary_data.size() : message.message.size());
+        priority = std::min(priority, message.priority);
+        should_retry = should_retry || message.should_retry;
+    }
+
+    std::vector<uint8_t> buffer = BinaryBufferPool::getInstance().acquire();
+    BinaryWriter writer(buffer, size);
+    writer.header(BinaryEncoderType::Signal_Batch_Encoder, "");
+    writer.u32(static_cast<uint32_t>(indices.size()));
+    for (size_t index : indices)
+    {
+        const WebSocketMessage& message = *messages[index].second;
+        if (message.webSocket_Message_type == WebSocketMessageType::Binary)
+        {
+            writer.u8(1);
+            writer.u32(static_cast<uint32_t>(message.binary_data.size()));
+            writer.bytes(message.binary_data.data(), message.binary_data.size());
+        }
+        else
+        {
+            writer.u8(0);
+            writer.u32(static_cast<uint32_t>(message.message.size()));
+            writer.bytes(message.message.data(), message.message.size());
+        }
+    }
+    return std::make_shared<WebSocketMessage>(std::move(buffer), priority, should_retry);
+}
+
+void WebSocketServer::broadcast_signals_to_websocket(const std::vector<std::pair<std::string, std::shared_ptr<WebSocketMessage>>>& messages)
+{
+    if (messages.size() == 1)
+    {
+        broadcast_signal_to_websocket(messages.front().first, messages.front().second);
+        return;
+    }
+
+    // The messages each session subscribes to, as indices into messages.
+    std::unordered_map<std::string, std::vector<size_t>> session_messages;
+    {
+        std::lock_guard<std::mutex> lock(signal_subscriptions_mutex_);
+        for (size_t i = 0; i < messages.size(); ++i)
+        {
+            auto it = signal_subscriptions_.find(messages[i].first);
+            if (it == signal_subscriptions_.end())
+            {
+                continue;
+            }
+            for (const auto& session_id : it->second)
+            {
+                session_messages[session_id].push_back(i);
+            }
+        }
+    }
+
+    // Sessions with the same subscriptions share one frame, a session with a single match gets the plain message.
+    std::map<std::vector<size_t>, std::shared_ptr<WebSocketMessage>> frames;
+    for (const auto& [session_id, indices] : session_messages)
+    {
+        auto& frame = frames[indices];
+        if (!frame)
+        {
+            frame = indices.size() == 1 ? messages[indices.front()].second : encode_batch_message(messages, indices);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(sessions_mutex_);
+    logger_->debug("Broadcast batch of {} signals to WebSocket.", messages.size());
+    for (const auto& [session_id, indices] : session_messages)
+    {
+        auto it = sessions_.find(session_id);
+        if (it != sessions_.end())
+        {
+            auto& session = it->second;
+            if (session && session->isRunning())
+            {
+                session->sendMessage(frames[indices]);
+            }
+        }
+    }
+}
+
  void WebSocketServer::subscribe_session_to_signal(const std::string& session_id, const std::string& signal_name)
 {
     std::lock_guard<std::mutex> lock(signal_subscriptions_mutex_);
-    signal_subscriptions_[signal_name].insert(session_id);
+    auto& subscribers = signal_subscriptions_[signal_name];
+    subscribers.insert(session_id);
+    update_subscriber_count(signal_name, subscribers.size());
     logger_->info("Session {} subscribed to signal {}", session_id, signal_name);
 }
 
@@ -261,6 +357,7 @@ void WebSocketServer::unsubscribe_session_from_signal(const std::string& session
     if (it != signal_subscriptions_.end())
     {
         it->second.erase(session_id);
+        update_subscriber_count(signal_name, it->second.size());
         if (it->second.empty())
         {
             signal_subscriptions_.erase(it);
@@ -276,6 +373,7 @@ void WebSocketServer::unsubscribe_session_from_all_signals(const std::string& se
     for (auto it = signal_subscriptions_.begin(); it != signal_subscriptions_.end(); )
     {
         it->second.erase(session_id);
+        update_subscriber_count(it->first, it->second.size());
         if (it->second.empty())
             it = signal_subscriptions_.erase(it);
         else
@@ -284,6 +382,34 @@ void WebSocketServer::unsubscribe_session_from_all_signals(const std::string& se
     logger_->info("Session {} unsubscribed from all signals", session_id);
 }
 
+std::shared_ptr<const std::atomic<size_t>> WebSocketServer::get_subscriber_count(const std::string& signal_name)
+{
+    std::lock_guard<std::mutex> lock(signal_subscriptions_mutex_);
+    auto& count = subscriber_counts_[signal_name];
+    if (!count)
+    {
+        auto it = signal_subscriptions_.find(signal_name);
+        count = std::make_shared<std::atomic<size_t>>(it != signal_subscriptions_.end() ? it->second.size() : 0);
+    }
+    return count;
+}
+
+void WebSocketServer::update_subscriber_count(const std::string& signal_name, size_t count)
+{
+    auto it = subscriber_counts_.find(signal_name);
+    if (it == subscriber_counts_.end())
+    {
+        // No publisher holds a handle yet, get_subscriber_count seeds a new one from signal_subscriptions_.
+        return;
+    }
+    it->second->store(count, std::memory_order_relaxed);
+    // Kept while a publisher still holds the handle, otherwise a name nobody subscribes to is forgotten.
+    if (count == 0 && it->second.use_count() == 1)
+    {
+        subscriber_counts_.erase(it);
+    }
+}
+
 void WebSocketServer::do_accept()
 {
     auto self = shared_from_this();
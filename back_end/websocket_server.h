@@ -40,9 +40,14 @@ public:
 
     //Signal management
     void broadcast_signal_to_websocket(const std::string& signal_name, std::shared_ptr<WebSocketMessage> webSocketMessage);
+    // Messages of signals committed together, as (signal name, message). Each session gets the ones it
+    // subscribes to in a single Signal_Batch_Encoder frame.
+    void broadcast_signals_to_websocket(const std::vector<std::pair<std::string, std::shared_ptr<WebSocketMessage>>>& messages);
     void subscribe_session_to_signal(const std::string& session_id, const std::string& signal_name);
     void unsubscribe_session_from_signal(const std::string& session_id, const std::string& signal_name);
     void unsubscribe_session_from_all_signals(const std::string& session_id);    
+    // Live subscriber count for a signal, so a publisher can skip encoding with one atomic load.
+    std::shared_ptr<const std::atomic<size_t>> get_subscriber_count(const std::string& signal_name);
 
     void register_notification_client(const std::string& client_name, WebSocketServerNotificationClient* client);
     void unregister_notification_client(const std::string& client_name);
@@ -64,8 +69,14 @@ private:
     std::mutex notification_clients_mutex_;
 
     std::unordered_map<std::string, std::unordered_set<std::string>> signal_subscriptions_;
+    // Created by get_subscriber_count, erased at zero subscribers once no publisher holds the handle.
+    // Guarded by signal_subscriptions_mutex_.
+    std::unordered_map<std::string, std::shared_ptr<std::atomic<size_t>>> subscriber_counts_;
     std::mutex signal_subscriptions_mutex_;
 
+    // Called with signal_subscriptions_mutex_ held.
+    void update_subscriber_count(const std::string& signal_name, size_t count);
+
     std::vector<std::thread> thread_pool_;
     unsigned int thread_count_;
 
@@ -10,8 +10,10 @@ const std::unordered_map<std::string, MessageTypeHelper::MessageType> MessageTyp
     {"signal subscribe message", MessageTypeHelper::MessageType::Signal_Subscribe_Message},
     {"signal unsubscribe message", MessageTypeHelper::MessageType::Signal_Unsubscribe_Message},
     {"signal value request message", MessageTypeHelper::MessageType::Signal_Value_Request_Message},
+    {"signal history request message", MessageTypeHelper::MessageType::Signal_History_Request_Message},
     {"text message", MessageTypeHelper::MessageType::Text_Message},
     {"signal value message", MessageTypeHelper::MessageType::Signal_Value_Message},
+    {"signal layout message", MessageTypeHelper::MessageType::Signal_Layout_Message},
     {"echo message", MessageTypeHelper::MessageType::Echo_Message},
     {"unknown", MessageTypeHelper::MessageType::Unknown},
 };
@@ -20,8 +22,10 @@ const std::unordered_map<MessageTypeHelper::MessageType, std::string> MessageTyp
     {MessageTypeHelper::MessageType::Signal_Subscribe_Message, "signal subscribe message"},
     {MessageTypeHelper::MessageType::Signal_Unsubscribe_Message, "signal unsubscribe message"},
     {MessageTypeHelper::MessageType::Signal_Value_Request_Message, "signal value request message"},
+    {MessageTypeHelper::MessageType::Signal_History_Request_Message, "signal history request message"},
     {MessageTypeHelper::MessageType::Text_Message, "text message"},
     {MessageTypeHelper::MessageType::Signal_Value_Message, "signal value message"},
+    {MessageTypeHelper::MessageType::Signal_Layout_Message, "signal layout message"},
     {MessageTypeHelper::MessageType::Echo_Message, "echo message"},
     {MessageTypeHelper::MessageType::Unknown, "unknown"},
 };
@@ -140,6 +144,10 @@ void WebSocketSessionMessageManager::handleStringMessage(const std::string& mess
             handleSignalValueRequest(incoming);
             break;
 
+        case MessageType::Signal_History_Request_Message:
+            handleSignalHistoryRequest(incoming);
+            break;
+
         case MessageType::Text_Message:
             handleTextMessage(incoming);
             break;
@@ -164,7 +172,8 @@ void WebSocketSessionMessageManager::handleSignalSubscribe(const json& incoming)
         {
             if(subscribeToSignal(incoming["signal"]))
             {
-                signal->handleWebSocketValueRequest();
+                sendSignalLayout(signal);
+                sendSignalValue(signal);
             }
         }
         else
@@ -225,13 +234,13 @@ void WebSocketSessionMessageManager::handleSignalValueRequest(const json& incomi
     logger_->info("Handle signal value request message.");
     if(incoming.contains("signal") && incoming["signal"].is_string())
     {
-        std::string signal_name = incoming["request"].get<std::string>();
+        std::string signal_name = incoming["signal"].get<std::string>();
         if(isSubscribedToSignal(signal_name))
         {
             auto signal = SignalManager::getInstance().getSharedSignalByName(signal_name);
             if(signal)
             {
-                signal->handleWebSocketValueRequest();
+                sendSignalValue(signal);
             }
             else
             {   
@@ -255,6 +264,97 @@ void WebSocketSessionMessageManager::handleSignalValueRequest(const json& incomi
     }
 }
 
+// Optional "from" / "to" in milliseconds since epoch and "last" entry count, see SignalHistoryQuery.
+void WebSocketSessionMessageManager::handleSignalHistoryRequest(const json& incoming)
+{
+    logger_->info("Handle signal history request message.");
+    if(!incoming.contains("signal") || !incoming["signal"].is_string())
+    {
+        std::string response = "Signal history request message missing signal.";
+        logger_->warn(response);
+        sendEchoResponse(response);
+        return;
+    }
+
+    std::string signal_name = incoming["signal"].get<std::string>();
+    auto signal = SignalManager::getInstance().getSharedSignalByName(signal_name);
+    if(!signal)
+    {
+        std::string response = "Signal \"" + signal_name + "\" not found.";
+        logger_->warn(response);
+        sendEchoResponse(response);
+        return;
+    }
+
+    SignalHistoryQuery query;
+    if(incoming.contains("from") && incoming["from"].is_number_unsigned())
+    {
+        query.fromMs = incoming["from"].get<uint64_t>();
+    }
+    if(incoming.contains("to") && incoming["to"].is_number_unsigned())
+    {
+        query.toMs = incoming["to"].get<uint64_t>();
+    }
+    if(incoming.contains("last") && incoming["last"].is_number_unsigned())
+    {
+        query.last = incoming["last"].get<size_t>();
+    }
+
+    auto message = signal->getWebSocketHistoryMessage(query);
+    if(!message)
+    {
+        std::string response = "Signal \"" + signal_name + "\" keeps no history.";
+        logger_->warn(response);
+        sendEchoResponse(response);
+        return;
+    }
+
+    auto session = session_.lock();
+    if (!session)
+    {
+        logger_->warn("handleSignalHistoryRequest failed: session expired");
+        return;
+    }
+    session->sendMessage(std::move(message));
+}
+
+// Only the requesting session gets the value, other subscribers already have it.
+void WebSocketSessionMessageManager::sendSignalValue(const std::shared_ptr<SignalName>& signal)
+{
+    auto session = session_.lock();
+    if (!session)
+    {
+        logger_->warn("sendSignalValue failed: session expired");
+        return;
+    }
+    auto message = signal->getWebSocketValueMessage();
+    if (message)
+    {
+        session->sendMessage(std::move(message));
+    }
+    else
+    {
+        logger_->debug("Signal \"{}\" has no websocket value to send.", signal->getName());
+    }
+}
+
+// Layout the signal's values refer to, e.g. band labels, sent once so the value frames can leave it out.
+void WebSocketSessionMessageManager::sendSignalLayout(const std::shared_ptr<SignalName>& signal)
+{
+    auto message = signal->getWebSocketLayoutMessage();
+    if (!message)
+    {
+        return;
+    }
+    auto session = session_.lock();
+    if (!session)
+    {
+        logger_->warn("sendSignalLayout failed: session expired");
+        return;
+    }
+    session->sendMessage(std::move(message));
+}
+
 bool WebSocketSessionMessageManager::isSubscribedToSignal(const std::string& signal_name) const
 {
     std::lock_guard<std::mutex> lock(subscription_mutex_);
@@ -17,6 +17,7 @@
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include "logger.h"
+#include "binary_buffer_pool.h"
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
@@ -27,6 +28,7 @@ namespace websocket = beast::websocket;
 using tcp = net::ip::tcp;
 
 class WebSocketServer;
+class SignalName;
 class MessageTypeHelper
 {
 public:
@@ -35,8 +37,10 @@ public:
         Signal_Subscribe_Message,
         Signal_Unsubscribe_Message,
         Signal_Value_Request_Message,
+        Signal_History_Request_Message,
         Text_Message,
         Signal_Value_Message,
+        Signal_Layout_Message,
         Echo_Message,
         Unknown
     };
@@ -73,6 +77,16 @@ struct WebSocketMessage
                     : message(msg), webSocket_Message_type(WebSocketMessageType::Text), priority(p), should_retry(retry_flag) {}
     WebSocketMessage( const std::vector<uint8_t>& data, MessagePriority p = MessagePriority::Low, bool retry_flag = false )
                     : binary_data(data), webSocket_Message_type(WebSocketMessageType::Binary), priority(p), should_retry(retry_flag) {}
+    WebSocketMessage( std::vector<uint8_t>&& data, MessagePriority p = MessagePriority::Low, bool retry_flag = false )
+                    : binary_data(std::move(data)), webSocket_Message_type(WebSocketMessageType::Binary), priority(p), should_retry(retry_flag) {}
+    WebSocketMessage(const WebSocketMessage&) = default;
+    WebSocketMessage(WebSocketMessage&&) = default;
+    WebSocketMessage& operator=(const WebSocketMessage&) = default;
+    WebSocketMessage& operator=(WebSocketMessage&&) = default;
+    ~WebSocketMessage()
+    {
+        BinaryBufferPool::getInstance().release(std::move(binary_data));
+    }
 };
 
 class WebSocketSession;
@@ -99,10 +113,13 @@ class WebSocketSessionMessageManager : public MessageTypeHelper
         void handleSignalSubscribe(const json& incoming);
         void handleSignalUnsubscribe(const json& incoming);
         void handleSignalValueRequest(const json& incoming);
+        void handleSignalHistoryRequest(const json& incoming);
         void handleTextMessage(const json& incoming);
         void handleSignalValueMessage(const json& incoming);
         void handleEchoMessage(const json& incoming);
         void handleUnknownMessage(const json& incoming);
+        void sendSignalValue(const std::shared_ptr<SignalName>& signal);
+        void sendSignalLayout(const std::shared_ptr<SignalName>& signal);
 
         std::string createEchoResponse(const std::string& message);
         void sendEchoResponse(const std::string& msg, MessagePriority priority = MessagePriority::Low);
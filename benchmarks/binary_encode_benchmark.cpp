@@ -0,0 +1,54 @@
+// Encode throughput of a binary websocket frame, fresh buffer per message against the BinaryBufferPool.
+// Build with -DBUILD_BENCHMARKS=ON and run output/binary_encode_benchmark [values per frame] [frames].
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+#include "signals/DataTypesAndEncoders/DataTypesAndEncoders.h"
+
+namespace
+{
+    const std::string SIGNAL_NAME = "FFT Bands Mono Mel Energies";
+
+    // Encodes frames messages and lets each one go, the way a broadcast message dies once it is written.
+    template<typename AcquireBuffer>
+    double encodeBytesPerSecond(const std::vector<float>& values, size_t frames, AcquireBuffer acquireBuffer)
+    {
+        const BinaryEncoder<std::vector<float>> encoder = get_timestamped_float_vector_encoder();
+        size_t bytes = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < frames; ++i)
+        {
+            std::vector<uint8_t> buffer = acquireBuffer();
+            encoder(SIGNAL_NAME, values, buffer);
+            bytes += buffer.size();
+            auto message = std::make_shared<WebSocketMessage>(std::move(buffer));
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return bytes / seconds;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const size_t valueCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1024;
+    const size_t frames = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200000;
+    std::vector<float> values(valueCount);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = static_cast<float>(i) * 0.5f;
+    }
+
+    // Warm up the pool and the allocator before measuring.
+    encodeBytesPerSecond(values, frames / 10, [] { return BinaryBufferPool::getInstance().acquire(); });
+
+    const double fresh = encodeBytesPerSecond(values, frames, [] { return std::vector<uint8_t>(); });
+    const double pooled = encodeBytesPerSecond(values, frames, [] { return BinaryBufferPool::getInstance().acquire(); });
+    std::printf("%zu floats per frame, %zu frames\n", valueCount, frames);
+    std::printf("  fresh buffer: %8.1f MB/s\n", fresh / 1e6);
+    std::printf("  pooled:       %8.1f MB/s\n", pooled / 1e6);
+    return 0;
+}
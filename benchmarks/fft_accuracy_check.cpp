@@ -0,0 +1,226 @@
+// Compares the fixed point FFT Computer against the float one on a sine and on noise. Built twice from this file,
+// fft_accuracy_float writes its frames with --write <file>, fft_accuracy_fixed reads them with --compare <file> and
+// reports the largest band and BinData differences. Build with -DBUILD_BENCHMARKS=ON and run the
+// fft_accuracy_check target, which does both. Returns non zero when a difference exceeds its bound.
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "fft_computer.h"
+
+namespace
+{
+    constexpr size_t FFT_SIZE = 8192;
+    constexpr size_t HOP_SIZE = 512;        // FFTComputer's default hop
+    constexpr size_t PACKET_SIZE = 1024;
+    constexpr size_t PACKETS = 94;
+    constexpr unsigned int SAMPLE_RATE = 48000;
+    constexpr int32_t MAX_VALUE = (1 << 23) - 1;   // S24
+    // Normalized bands span Min db to Max db, wide enough that no band clips at the top.
+    constexpr float MIN_DB = 0.0f;
+    constexpr float MAX_DB = 160.0f;
+    // The bound documented in FFTComputer::buildPlan, for bands at or above 0 dB.
+    constexpr float BAND_ERROR_BOUND_DB = 0.11f;
+    // Parabolic peak interpolation places a Hann windowed sine within a few hundredths of a bin.
+    constexpr float PEAK_ERROR_BOUND_BINS = 0.05f;
+
+    struct Frame
+    {
+        std::array<float, 32> bands = {};       // Normalized, as published
+        float peakFrequency = 0.0f;
+        float normalizedMaxValue = 0.0f;
+        uint16_t maxBin = 0;
+    };
+
+    std::vector<Frame> analyse(const std::string& name, const std::vector<int32_t>& samples)
+    {
+        SignalManager& signalManager = SignalManager::getInstance();
+        const std::string input = name + " Input";
+        for (const char* suffix : { "", " Left Channel", " Right Channel" })
+        {
+            signalManager.createSignal<std::vector<int32_t>>(input + suffix);
+        }
+        auto minDb = signalManager.createSignal(SignalKeys::MinDb);
+        auto maxDb = signalManager.createSignal(SignalKeys::MaxDb);
+
+        std::mutex mutex;
+        std::vector<std::vector<float>> bands;
+        std::vector<BinData> binData;
+        // Every packet is processed on its own and every frame is published, no frame is merged or dropped.
+        FFTComputer fft(name, input, name + " Bands", FFT_SIZE, SAMPLE_RATE, MAX_VALUE, nullptr, PACKETS, FFTQueueOverflowPolicy::DropOldest);
+        minDb->setValue(MIN_DB);
+        maxDb->setValue(MAX_DB);
+
+        // Repeated values still count as frames.
+        auto bandsSignal = signalManager.createSignal<std::vector<float>>(name + " Bands");
+        auto binDataSignal = signalManager.createSignal<BinData>(name + " Bands Mono Bin Data");
+        bandsSignal->setChangeDetection(ChangeDetection::AlwaysPublish);
+        binDataSignal->setChangeDetection(ChangeDetection::AlwaysPublish);
+        bandsSignal->registerSignalValueCallback([&](const std::vector<float>& value, void*)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            bands.push_back(value);
+        }, &bands);
+        binDataSignal->registerSignalValueCallback([&](const BinData& value, void*)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            binData.push_back(value);
+        }, &binData);
+
+        for (size_t offset = 0; offset + PACKET_SIZE <= samples.size(); offset += PACKET_SIZE)
+        {
+            fft.addData(std::vector<int32_t>(samples.begin() + offset, samples.begin() + offset + PACKET_SIZE), ChannelType::Mono);
+        }
+
+        // One frame per hop once the first full window is in.
+        const size_t expectedFrames = samples.size() / HOP_SIZE - FFT_SIZE / HOP_SIZE + 1;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+        while (std::chrono::steady_clock::now() < deadline)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (bands.size() >= expectedFrames && binData.size() >= expectedFrames) break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        bandsSignal->unregisterSignalValueCallbackByArg(&bands);
+        binDataSignal->unregisterSignalValueCallbackByArg(&binData);
+
+        std::vector<Frame> frames(std::min(bands.size(), binData.size()));
+        for (size_t i = 0; i < frames.size(); ++i)
+        {
+            std::copy_n(bands[i].begin(), std::min(bands[i].size(), frames[i].bands.size()), frames[i].bands.begin());
+            frames[i].peakFrequency = binData[i].peakFrequency;
+            frames[i].normalizedMaxValue = binData[i].normalizedMaxValue;
+            frames[i].maxBin = binData[i].maxBin;
+        }
+        if (frames.size() != expectedFrames)
+        {
+            std::printf("%s: expected %zu frames, got %zu\n", name.c_str(), expectedFrames, frames.size());
+        }
+        return frames;
+    }
+
+    std::vector<int32_t> sine(float frequency, float amplitude)
+    {
+        std::vector<int32_t> samples(PACKETS * PACKET_SIZE);
+        for (size_t i = 0; i < samples.size(); ++i)
+        {
+            samples[i] = static_cast<int32_t>(std::lround(amplitude * MAX_VALUE * std::sin(2.0 * M_PI * frequency * i / SAMPLE_RATE)));
+        }
+        return samples;
+    }
+
+    std::vector<int32_t> noise(float rms)
+    {
+        std::mt19937 generator(1234);
+        std::normal_distribution<double> distribution(0.0, rms * MAX_VALUE);
+        std::vector<int32_t> samples(PACKETS * PACKET_SIZE);
+        for (int32_t& sample : samples)
+        {
+            sample = static_cast<int32_t>(std::clamp<double>(std::round(distribution(generator)), -MAX_VALUE, MAX_VALUE));
+        }
+        return samples;
+    }
+
+    void write(std::ofstream& file, const std::vector<Frame>& frames)
+    {
+        const uint64_t count = frames.size();
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        file.write(reinterpret_cast<const char*>(frames.data()), static_cast<std::streamsize>(frames.size() * sizeof(Frame)));
+    }
+
+    std::vector<Frame> read(std::ifstream& file)
+    {
+        uint64_t count = 0;
+        file.read(reinterpret_cast<char*>(&count), sizeof(count));
+        std::vector<Frame> frames(file ? count : 0);
+        file.read(reinterpret_cast<char*>(frames.data()), static_cast<std::streamsize>(frames.size() * sizeof(Frame)));
+        return frames;
+    }
+
+    // Differences in dB, only where both builds put the band above Min db, below it both read 0.
+    bool compare(const std::string& name, const std::vector<Frame>& reference, const std::vector<Frame>& frames, bool checkPeak)
+    {
+        if (reference.empty() || reference.size() != frames.size())
+        {
+            std::printf("%s: %zu reference frames, %zu frames, nothing to compare\n", name.c_str(), reference.size(), frames.size());
+            return false;
+        }
+        const float dbPerUnit = MAX_DB - MIN_DB;
+        const float binResolution = static_cast<float>(SAMPLE_RATE) / FFT_SIZE;
+        float bandError = 0.0f;
+        float maxValueError = 0.0f;
+        float peakError = 0.0f;
+        size_t bandsCompared = 0;
+        size_t maxBinMismatches = 0;
+        for (size_t f = 0; f < frames.size(); ++f)
+        {
+            for (size_t b = 0; b < frames[f].bands.size(); ++b)
+            {
+                if (reference[f].bands[b] <= 0.0f || frames[f].bands[b] <= 0.0f) continue;
+                bandError = std::max(bandError, std::abs(frames[f].bands[b] - reference[f].bands[b]) * dbPerUnit);
+                ++bandsCompared;
+            }
+            maxValueError = std::max(maxValueError, std::abs(frames[f].normalizedMaxValue - reference[f].normalizedMaxValue) * dbPerUnit);
+            peakError = std::max(peakError, std::abs(frames[f].peakFrequency - reference[f].peakFrequency));
+            maxBinMismatches += frames[f].maxBin != reference[f].maxBin;
+        }
+
+        std::printf("%s: %zu frames\n", name.c_str(), frames.size());
+        std::printf("  bands:     max error %.4f dB over %zu bands at or above %.0f dB (bound %.2f dB)\n", bandError, bandsCompared, MIN_DB, BAND_ERROR_BOUND_DB);
+        std::printf("  bin data:  max value error %.4f dB, peak frequency error %.3f Hz (%.4f bins), %zu max bin mismatches\n", maxValueError, peakError, peakError / binResolution, maxBinMismatches);
+
+        bool passed = bandError <= BAND_ERROR_BOUND_DB && maxValueError <= BAND_ERROR_BOUND_DB;
+        if (checkPeak)
+        {
+            // Noise has no single peak, near equal bins may swap places, only the sine must find the same one.
+            passed = passed && maxBinMismatches == 0 && peakError <= PEAK_ERROR_BOUND_BINS * binResolution;
+        }
+        return passed;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3 || (std::strcmp(argv[1], "--write") != 0 && std::strcmp(argv[1], "--compare") != 0))
+    {
+        std::printf("usage: %s --write|--compare <file>\n", argv[0]);
+        return 2;
+    }
+    const bool writing = std::strcmp(argv[1], "--write") == 0;
+#ifdef FIXED_POINT
+    std::printf("Fixed point (%d bit) FFT Computer\n", FIXED_POINT);
+#else
+    std::printf("Float FFT Computer\n");
+#endif
+
+    // A 1 kHz sine at -6 dBFS and white noise at -40 dBFS, where fixed point rounding matters most.
+    const std::vector<Frame> sineFrames = analyse("Accuracy Sine", sine(1000.0f, 0.5f));
+    const std::vector<Frame> noiseFrames = analyse("Accuracy Noise", noise(0.01f));
+
+    if (writing)
+    {
+        std::ofstream file(argv[2], std::ios::binary);
+        write(file, sineFrames);
+        write(file, noiseFrames);
+        std::printf("Wrote %zu sine and %zu noise frames to %s\n", sineFrames.size(), noiseFrames.size(), argv[2]);
+        return file ? 0 : 1;
+    }
+
+    std::ifstream file(argv[2], std::ios::binary);
+    const std::vector<Frame> sineReference = read(file);
+    const std::vector<Frame> noiseReference = read(file);
+    const bool sinePassed = compare("Sine", sineReference, sineFrames, true);
+    const bool noisePassed = compare("Noise", noiseReference, noiseFrames, false);
+    std::printf("%s\n", sinePassed && noisePassed ? "PASS" : "FAIL");
+    return sinePassed && noisePassed ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+// Publish and read throughput of one Signal<std::vector<float>> shared by a writer and N reader threads.
+// Build with -DBUILD_BENCHMARKS=ON and run output/signal_contention_benchmark [readers] [seconds] [values].
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "signals/signal.h"
+
+namespace
+{
+    struct Result
+    {
+        double publishesPerSecond = 0.0;
+        double readsPerSecond = 0.0;
+    };
+
+    // copyValue reads through getValue, which copies the vector, otherwise readers only take the snapshot.
+    Result run(const std::shared_ptr<Signal<std::vector<float>>>& signal, size_t readers, double seconds, size_t values, bool copyValue)
+    {
+        // Alternating values, so every publish passes change detection.
+        const std::vector<float> even(values, 1.0f);
+        const std::vector<float> odd(values, 2.0f);
+        signal->setValue(even);
+
+        std::atomic<bool> stop{false};
+        std::atomic<uint64_t> reads{0};
+        std::atomic<float> sink{0.0f};
+        std::vector<std::thread> readerThreads;
+        for (size_t r = 0; r < readers; ++r)
+        {
+            readerThreads.emplace_back([&]()
+            {
+                uint64_t count = 0;
+                float sum = 0.0f;
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    if (copyValue)
+                    {
+                        sum += signal->getValue().back();
+                    }
+                    else
+                    {
+                        sum += signal->GetData()->back();
+                    }
+                    ++count;
+                }
+                reads += count;
+                sink = sink + sum;
+            });
+        }
+
+        uint64_t publishes = 0;
+        const auto start = std::chrono::steady_clock::now();
+        const auto end = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+        while (std::chrono::steady_clock::now() < end)
+        {
+            signal->setValue((publishes & 1) ? even : odd);
+            ++publishes;
+        }
+        stop = true;
+        for (std::thread& thread : readerThreads)
+        {
+            thread.join();
+        }
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return Result{publishes / elapsed, reads / elapsed};
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const size_t readers = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4;
+    const double seconds = argc > 2 ? std::strtod(argv[2], nullptr) : 2.0;
+    const size_t values = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 1024;
+
+    auto signal = SignalManager::getInstance().createSignal<std::vector<float>>("Contention Benchmark");
+    std::printf("1 writer, %zu readers, %zu floats, %.1f s per run\n", readers, values, seconds);
+    for (bool copyValue : { false, true })
+    {
+        const Result result = run(signal, readers, seconds, values, copyValue);
+        std::printf("  %-9s publishes %10.0f /s, reads %12.0f /s\n", copyValue ? "getValue" : "GetData", result.publishesPerSecond, result.readsPerSecond);
+    }
+    return 0;
+}
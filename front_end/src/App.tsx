@@ -14,6 +14,7 @@ import {
   TableOutlined,
   HeatMapOutlined,
   LineChartOutlined,
+  DotChartOutlined,
   PlayCircleOutlined,
   ArrowLeftOutlined,
 } from '@ant-design/icons';
@@ -51,6 +52,7 @@ const MENU_STRUCTURE = {
       { key: 'horizontal stereo spectrum', targetScreen: SCREENS.HORIZONTAL_STEREO_SPECTRUM, label: 'Stereo Spectrum', icon: <BarChartOutlined style={{ fontSize: '50px' }} /> },
       { key: 'vertical stereo spectrum', targetScreen: SCREENS.VERTICAL_STEREO_SPECTRUM, label: 'Vertical Stereo Spectrum', icon: <BarChartOutlined style={{ fontSize: '50px', transform: 'scaleX(-1) rotate(-90deg)' }} /> },
       { key: 'wave screen', targetScreen: SCREENS.WAVE_SCREEN, label: 'Wave Screen', icon: <LineChartOutlined style={{ fontSize: '50px' }} /> },
+      { key: 'stereo field', targetScreen: SCREENS.STEREO_FIELD, label: 'Stereo Field', icon: <DotChartOutlined style={{ fontSize: '50px' }} /> },
       { key: 'heat map', targetMenu: 'heatmap', label: 'Heat Map', icon: <HeatMapOutlined style={{ fontSize: '50px' }} /> },
       { key: 'back', targetMenu: 'main', label: 'Back', icon: <ArrowLeftOutlined style={{ fontSize: '50px' }} /> },
     ],
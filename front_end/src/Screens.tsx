@@ -11,6 +11,7 @@ import HorizontalGauge from './components/HorizontalGauge';
 import { WebSocketContextType } from './components/WebSocketContext';
 import Incrementer from './components/Incrementer';
 import ValueSelector from './components/ValueSelector';
+import Goniometer from './components/Goniometer';
 export type ScreenType = (typeof SCREENS)[keyof typeof SCREENS];
 
 interface ScreenProps {
@@ -28,6 +29,7 @@ export const SCREENS = {
   HORIZONTAL_STEREO_SPECTRUM: 'horizontal stereo spectrum',
   VERTICAL_STEREO_SPECTRUM: 'vertical stereo spectrum',
   WAVE_SCREEN: 'wave screen',
+  STEREO_FIELD: 'stereo field',
   SCROLLING_HEAT_MAP: 'scrolling heat map screen',
   SCROLLING_HEAT_MAP_RAINBOW: 'scrolling heat map rainbow',
   SETTING_SENSITIVITY: 'setting sensitivity',
@@ -47,6 +49,8 @@ export const renderScreen = ({ socket, screen }: RenderScreenParams) => {
           return <VerticalStereoSpectrumScreen socket={socket} />;
         case SCREENS.WAVE_SCREEN:
           return <WaveScreen socket={socket}  />;
+        case SCREENS.STEREO_FIELD:
+          return <StereoFieldScreen socket={socket} />;
         case SCREENS.SCROLLING_HEAT_MAP_RAINBOW:
           return <ScrollingHeatMapRainbowScreen socket={socket} />;
         case SCREENS.SCROLLING_HEAT_MAP:
@@ -175,6 +179,14 @@ export function TowerScreen({ socket }: ScreenProps) {
     );
   }
 
+export function StereoFieldScreen({ socket }: ScreenProps) {
+    return (
+      <div style={{ width: '100%', height: '100%' }}>
+        <Goniometer signal="Stereo Field" socket={socket} />
+      </div>
+    );
+}
+
 export function ScrollingHeatMapRainbowScreen({ socket }: ScreenProps) {
     return (
       <RenderTickProvider>
@@ -214,8 +226,8 @@ export function ScrollingHeatMapScreen({ socket }: ScreenProps) {
         <div style={{ display: 'flex', width: '100%', height: '100%' }}>
           <div style={{ width: '50%', height: '100%' }}>
             <ScrollingHeatmap
-              signal="FFT Bands Left Channel"
-              dataWidth={32}
+              signal="FFT Bands Left Spectrum"
+              dataWidth={128}
               dataHeight={1000}
               min={0}
               max={1}
@@ -228,8 +240,8 @@ export function ScrollingHeatMapScreen({ socket }: ScreenProps) {
           </div>
           <div style={{ width: '50%', height: '100%' }}>
             <ScrollingHeatmap
-              signal="FFT Bands Right Channel"
-              dataWidth={32}
+              signal="FFT Bands Right Spectrum"
+              dataWidth={128}
               dataHeight={1000}
               min={0}
               max={1}
@@ -323,6 +335,32 @@ export function SettingBrightnessScreen({ socket }: ScreenProps) {
           <Incrementer signal="Max db" socket={socket} min={0} max={140} step={1} units="dB" holdEnabled={true} holdIntervalMs={100} />
         </div>
 
+        {/* Analysis Engine */}
+        <div style={{ display: 'flex', flexDirection: 'row', alignItems: 'center', gap: 10, justifyContent: 'center' }}>
+          <div style={{ width: 200, textAlign: 'right' }}>
+            <h2 style={{ margin: 0, userSelect: 'none' }}>Analysis Engine</h2>
+          </div>
+          <ValueSelector
+            signal="Analysis Engine"
+            socket={socket}
+            options={['FFT', 'IIR Filterbank']}
+            label="Analysis Engine"
+          />
+        </div>
+
+        {/* dB Range Mode */}
+        <div style={{ display: 'flex', flexDirection: 'row', alignItems: 'center', gap: 10, justifyContent: 'center' }}>
+          <div style={{ width: 200, textAlign: 'right' }}>
+            <h2 style={{ margin: 0, userSelect: 'none' }}>dB Range Mode</h2>
+          </div>
+          <ValueSelector
+            signal="db Range Mode"
+            socket={socket}
+            options={['Manual', 'Auto']}
+            label="dB Range Mode"
+          />
+        </div>
+
         {/* Reference Table */}
         <table style={{
           borderCollapse: 'collapse',
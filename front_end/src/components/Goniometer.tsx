@@ -0,0 +1,160 @@
+import { Component, createRef } from 'react';
+import { WebSocketContextType, WebSocketMessage } from './WebSocketContext';
+
+interface GoniometerProps {
+    signal: string;
+    socket: WebSocketContextType;
+    color?: string;
+    persistence?: number; // 0–1, how much of the previous frame is kept
+}
+
+interface GoniometerState {
+    correlation: number;
+    balance: number;
+}
+
+export default class Goniometer extends Component<GoniometerProps, GoniometerState> {
+    private canvasRef = createRef<HTMLCanvasElement>();
+    private containerRef = createRef<HTMLDivElement>();
+    private points: Float32Array = new Float32Array(0);
+    private animationFrameId: number | null = null;
+    private dirty: boolean = false;
+
+    constructor(props: GoniometerProps) {
+        super(props);
+        this.state = {
+            correlation: 0,
+            balance: 0,
+        };
+    }
+
+    componentDidMount() {
+        this.setupSocket();
+        this.animationFrameId = requestAnimationFrame(this.renderLoop);
+    }
+
+    componentWillUnmount() {
+        this.teardownSocket();
+        if (this.animationFrameId !== null) {
+            cancelAnimationFrame(this.animationFrameId);
+            this.animationFrameId = null;
+        }
+    }
+
+    componentDidUpdate(prevProps: GoniometerProps) {
+        if (prevProps.signal !== this.props.signal) {
+            this.teardownSocket();
+            this.setupSocket();
+        }
+    }
+
+    setupSocket() {
+        const { socket, signal } = this.props;
+        if (!socket) return;
+
+        const onOpen = () => {
+            socket.subscribe(signal, this.handleSignalValue);
+        };
+        (this as any)._signalOnOpen = onOpen;
+        socket.onOpen(onOpen);
+
+        if (socket.isOpen?.()) {
+            socket.subscribe(signal, this.handleSignalValue);
+        }
+    }
+
+    teardownSocket() {
+        const { socket, signal } = this.props;
+        if (!socket) return;
+        socket.unsubscribe(signal, this.handleSignalValue);
+        const onOpen = (this as any)._signalOnOpen;
+        if (onOpen && socket.removeOnOpen) {
+            socket.removeOnOpen(onOpen);
+        }
+        delete (this as any)._signalOnOpen;
+    }
+
+    // Stereo field payload: timestamp(8), correlation(f32), balance(f32), count(2), count * (int16 side, int16 mid)
+    private handleSignalValue = (message: WebSocketMessage) => {
+        if (message.type !== 'binary' || message.payloadType !== 5) return;
+
+        const payload = message.payload;
+        const HEADER_LENGTH = 8 + 4 + 4 + 2;
+        if (payload.length < HEADER_LENGTH) return;
+
+        const view = new DataView(payload.buffer, payload.byteOffset, payload.byteLength);
+        const correlation = view.getFloat32(8);
+        const balance = view.getFloat32(12);
+        const count = view.getUint16(16);
+        if (payload.length < HEADER_LENGTH + count * 4) return;
+
+        const points = new Float32Array(count * 2);
+        for (let i = 0; i < count; i++) {
+            points[i * 2] = view.getInt16(HEADER_LENGTH + i * 4) / 32767;
+            points[i * 2 + 1] = view.getInt16(HEADER_LENGTH + i * 4 + 2) / 32767;
+        }
+        this.points = points;
+        this.dirty = true;
+        this.setState({ correlation, balance });
+    };
+
+    renderLoop = () => {
+        if (this.dirty) {
+            this.drawPoints();
+            this.dirty = false;
+        }
+        this.animationFrameId = requestAnimationFrame(this.renderLoop);
+    };
+
+    drawPoints() {
+        const canvas = this.canvasRef.current;
+        const container = this.containerRef.current;
+        if (!canvas || !container) return;
+
+        const ctx = canvas.getContext('2d');
+        if (!ctx) return;
+
+        const size = Math.floor(Math.min(container.clientWidth, container.clientHeight));
+        if (canvas.width !== size || canvas.height !== size) {
+            canvas.width = size;
+            canvas.height = size;
+        }
+
+        const persistence = this.props.persistence ?? 0.8;
+        ctx.fillStyle = `rgba(0, 0, 0, ${1 - persistence})`;
+        ctx.fillRect(0, 0, size, size);
+
+        // Mono and out of phase axes
+        const half = size / 2;
+        ctx.strokeStyle = '#333';
+        ctx.beginPath();
+        ctx.moveTo(half, 0);
+        ctx.lineTo(half, size);
+        ctx.moveTo(0, half);
+        ctx.lineTo(size, half);
+        ctx.stroke();
+
+        ctx.fillStyle = this.props.color || 'lime';
+        for (let i = 0; i < this.points.length; i += 2) {
+            const x = half + this.points[i] * half;
+            const y = half - this.points[i + 1] * half;
+            ctx.fillRect(x, y, 2, 2);
+        }
+    }
+
+    render() {
+        const { correlation, balance } = this.state;
+        return (
+            <div
+                ref={this.containerRef}
+                style={{ width: '100%', height: '100%', position: 'relative', display: 'flex', justifyContent: 'center', alignItems: 'center' }}
+                aria-label={`Goniometer for signal ${this.props.signal}`}
+            >
+                <canvas ref={this.canvasRef} style={{ display: 'block', backgroundColor: 'black' }} />
+                <div style={{ position: 'absolute', bottom: 10, left: 10, color: 'white', userSelect: 'none' }}>
+                    Correlation {correlation.toFixed(2)} | Balance {balance.toFixed(2)}
+                </div>
+            </div>
+        );
+    }
+}
@@ -1,5 +1,6 @@
 import { Component, createRef } from 'react';
 import { WebSocketContextType, WebSocketMessage } from './WebSocketContext';
+import { BAND_VECTOR_PAYLOAD_TYPE, decodeBandVector } from '../utils/BandVector';
 
 interface LiveBarChartProps {
     signal: string;
@@ -209,6 +210,15 @@ export default class LiveBarChart extends Component<LiveBarChartProps, LiveBarCh
             } else {
                 console.warn('Invalid signal value format:', value);
             }
+        } else if (message.type === 'signal layout message') {
+            if (Array.isArray(message.value?.labels)) {
+                this.setState({ dataLabels: message.value.labels });
+            }
+        } else if (message.type === 'binary' && message.payloadType === BAND_VECTOR_PAYLOAD_TYPE) {
+            const values = decodeBandVector(message.payload);
+            if (values) {
+                this.setState({ dataValues: values });
+            }
         } else if (message.type === 'binary') {
             console.warn('Received unsupported binary data.');
         } else {
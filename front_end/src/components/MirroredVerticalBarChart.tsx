@@ -1,5 +1,6 @@
 import { Component, createRef } from 'react';
 import { WebSocketContextType, WebSocketMessage } from './WebSocketContext';
+import { BAND_VECTOR_PAYLOAD_TYPE, decodeBandVector } from '../utils/BandVector';
 
 interface MirroredVerticalBarChartProps {
     leftSignal: string;
@@ -188,6 +189,18 @@ export default class MirroredVerticalBarChart extends Component<
                     rightValues: message.value.values,
                 });
             }
+        } else if (message.type === 'signal layout message') {
+            if (Array.isArray(message.value?.labels)) {
+                this.setState({ dataLabels: message.value.labels });
+            }
+        } else if (message.type === 'binary' && message.payloadType === BAND_VECTOR_PAYLOAD_TYPE) {
+            const values = decodeBandVector(message.payload);
+            if (!values) return;
+            if (message.signal === this.props.leftSignal) {
+                this.setState({ leftValues: values });
+            } else if (message.signal === this.props.rightSignal) {
+                this.setState({ rightValues: values });
+            }
         } else if (message.type === 'binary') {
             console.log('Received unsupported binary data.');
         }
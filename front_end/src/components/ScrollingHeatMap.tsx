@@ -1,5 +1,6 @@
 import { Component, createRef } from 'react';
 import { WebSocketContextType, WebSocketMessage } from './WebSocketContext';
+import { BAND_VECTOR_PAYLOAD_TYPE, decodeBandVector } from '../utils/BandVector';
 
 interface ScrollingHeatmapProps {
     signal: string;
@@ -130,22 +131,81 @@ export default class ScrollingHeatmap extends Component<ScrollingHeatmapProps, S
     }
 
     private handleSignalValue = (message: WebSocketMessage) => {
+        if (message.type === 'history') {
+            this.loadHistory(message.entries.map((entry) => this.rowFromMessage(entry.message)));
+            return;
+        }
+        const values = this.rowFromMessage(message);
+        if (values) {
+            this.queueRow(values);
+        }
+    };
+
+    private rowFromMessage(message: WebSocketMessage): number[] | null {
         if (message.type === 'signal value message') {
-            if (Array.isArray(message.value?.values)) {
-                const newRow = message.value.values.slice(0, this.maxCols);
-                this.lastRow =
-                    newRow.length === this.maxCols
-                        ? newRow
-                        : [...newRow, ...Array(this.maxCols - newRow.length).fill(0)];
+            return Array.isArray(message.value?.values) ? message.value.values : null;
+        } else if (message.type === 'binary' && message.payloadType === 3) {
+            return this.decodeSpectrumColumn(message.payload);
+        } else if (message.type === 'binary' && message.payloadType === BAND_VECTOR_PAYLOAD_TYPE) {
+            return decodeBandVector(message.payload);
+        }
+        return null;
+    }
 
-                this.dataQueue.push([...this.lastRow]); // clone to avoid reference issues
+    // History already covers the rows received since subscribing, so it replaces the buffer and is drawn at once.
+    private loadHistory(rows: (number[] | null)[]) {
+        this.resetBuffer();
+        for (const row of rows) {
+            if (row) this.queueRow(row);
+        }
+        while (this.dataQueue.length > 0) {
+            this.flushOneRowToBuffer();
+        }
+    }
 
-                if (this.dataQueue.length > 1000) {
-                    this.dataQueue.splice(0, this.dataQueue.length - 1000); // drop oldest overflow
-                }
-            }
+    private queueRow(values: number[]) {
+        const newRow = values.slice(0, this.maxCols);
+        this.lastRow =
+            newRow.length === this.maxCols
+                ? newRow
+                : [...newRow, ...Array(this.maxCols - newRow.length).fill(0)];
+
+        this.dataQueue.push([...this.lastRow]); // clone to avoid reference issues
+
+        if (this.dataQueue.length > 1000) {
+            this.dataQueue.splice(0, this.dataQueue.length - 1000); // drop oldest overflow
         }
-    };
+    }
+
+    // Spectrum column payload: timestamp(8), min_frequency(f32), max_frequency(f32), format(1), count(2), bins
+    private decodeSpectrumColumn(payload: Uint8Array): number[] | null {
+        const HEADER_LENGTH = 8 + 4 + 4 + 1 + 2;
+        if (payload.length < HEADER_LENGTH) return null;
+
+        const view = new DataView(payload.buffer, payload.byteOffset, payload.byteLength);
+        const format = view.getUint8(16);
+        const count = view.getUint16(17);
+        const valueSize = format === 1 ? 2 : 1;
+        if (payload.length < HEADER_LENGTH + count * valueSize) return null;
+
+        const values = new Array<number>(count);
+        for (let i = 0; i < count; i++) {
+            const offset = HEADER_LENGTH + i * valueSize;
+            values[i] = format === 1
+                ? this.halfToFloat(view.getUint16(offset))
+                : view.getUint8(offset) / 255;
+        }
+        return values;
+    }
+
+    private halfToFloat(half: number): number {
+        const sign = half & 0x8000 ? -1 : 1;
+        const exponent = (half >> 10) & 0x1f;
+        const fraction = half & 0x3ff;
+        if (exponent === 0) return sign * Math.pow(2, -14) * (fraction / 1024);
+        if (exponent === 0x1f) return fraction ? NaN : sign * Infinity;
+        return sign * Math.pow(2, exponent - 15) * (1 + fraction / 1024);
+    }
 
     setupSocket() {
         const { socket, signal } = this.props;
@@ -153,6 +213,7 @@ export default class ScrollingHeatmap extends Component<ScrollingHeatmapProps, S
 
         const onOpen = () => {
             socket.subscribe(signal, this.handleSignalValue);
+            socket.requestHistory(signal, { last: this.maxRows });
         };
         (this as any)._signalOnOpen = onOpen;
         socket.onOpen(onOpen);
@@ -13,7 +13,7 @@ export type ControlWebSocketMessage = {
 };
 
 export type SignalValueWebSocketMessage = {
-  type: 'text' | 'signal value message';
+  type: 'text' | 'signal value message' | 'signal layout message';
   signal: string;
   value?: any;
 };
@@ -25,7 +25,33 @@ export type BinaryWebSocketMessage = {
   payload: Uint8Array;
 };
 
-export type WebSocketMessage = ControlWebSocketMessage | SignalValueWebSocketMessage | BinaryWebSocketMessage;
+// Any of from / to (ms since epoch) and last, the server keeps entries in the range and then the newest last.
+export type HistoryRequestWebSocketMessage = {
+  type: 'signal history request message';
+  signal: string;
+  from?: number;
+  to?: number;
+  last?: number;
+};
+
+export type HistoryEntry = {
+  timestamp: number;
+  message: SignalValueWebSocketMessage | BinaryWebSocketMessage;
+};
+
+// A signal's history, oldest first, each entry decoded as if it had arrived live.
+export type HistoryWebSocketMessage = {
+  type: 'history';
+  signal: string;
+  entries: HistoryEntry[];
+};
+
+export type WebSocketMessage =
+  | ControlWebSocketMessage
+  | SignalValueWebSocketMessage
+  | BinaryWebSocketMessage
+  | HistoryRequestWebSocketMessage
+  | HistoryWebSocketMessage;
 
 export type WebSocketContextType = {
   socket: WebSocket | null;
@@ -35,6 +61,7 @@ export type WebSocketContextType = {
   onOpen: (callback: () => void) => void;
   removeOnOpen: (callback: () => void) => void;
   isOpen: () => boolean;
+  requestHistory: (signal: string, range: { from?: number; to?: number; last?: number }) => void;
 };
 
 export const WebSocketContext = createContext<WebSocketContextType>(null as any);
@@ -174,20 +201,37 @@ export const WebSocketProvider: React.FC<WebSocketProviderProps> = ({ url, child
     switch (messageType) {
       case 1:
       case 2:
+      case 3:
+      case 4:
+      case 5:
+      case 6:
         handleNamedBinaryEncoder(data);
         break;
+      case 7:
+        handleHistoryMessage(data);
+        break;
+      case 8:
+        handleBatchMessage(data);
+        break;
       default:
         console.warn('Unknown blob message type:', messageType);
     }
   };
 
   const handleNamedBinaryEncoder = (data: Uint8Array) => {
+    const message = parseNamedBinary(data);
+    if (message) {
+      handleCallbacks(message.signal, message);
+    }
+  };
+
+  const parseNamedBinary = (data: Uint8Array): BinaryWebSocketMessage | null => {
     const TYPE_HEADER_LENGTH = 1;
     const NAME_LENGTH_BYTES = 2;
 
     if (data.length < TYPE_HEADER_LENGTH + NAME_LENGTH_BYTES) {
         console.warn("Binary message too short.");
-        return;
+        return null;
     }
 
     const payloadType = data[0];
@@ -198,7 +242,7 @@ export const WebSocketProvider: React.FC<WebSocketProviderProps> = ({ url, child
 
     if (data.length < nameEnd) {
         console.warn(`Binary message truncated before signal name. Needed at least ${nameEnd}, got ${data.length}`);
-        return;
+        return null;
     }
 
     const nameBytes = data.subarray(nameStart, nameEnd);
@@ -208,7 +252,7 @@ export const WebSocketProvider: React.FC<WebSocketProviderProps> = ({ url, child
         signalName = decoder.decode(nameBytes);
     } catch (err) {
         console.error("Failed to decode signal name:", err);
-        return;
+        return null;
     }
 
     const payloadStart = nameEnd;
@@ -216,18 +260,85 @@ export const WebSocketProvider: React.FC<WebSocketProviderProps> = ({ url, child
 
     if (payload.length < 4) {
         console.warn(`Binary payload too short to include dimensions (rows/cols): ${payload.length}`);
-        return;
+        return null;
     }
 
     // Optional debug log:
     // console.log(`Decoded binary message. Signal: ${signalName}, Payload type: ${payloadType}, Payload length: ${payload.length}`);
 
-    handleCallbacks(signalName, {
+    return {
         type: 'binary',
         signal: signalName,
         payload,
         payloadType,
-    });
+    };
+  };
+
+  // History payload: count(4), count * (timestamp(8), format(1, 0 = text, 1 = binary), length(4), message)
+  const handleHistoryMessage = (data: Uint8Array) => {
+    const history = parseNamedBinary(data);
+    if (!history || history.payload.length < 4) return;
+
+    const payload = history.payload;
+    const view = new DataView(payload.buffer, payload.byteOffset, payload.byteLength);
+    const count = view.getUint32(0);
+    const decoder = new TextDecoder('utf-8');
+    const entries: HistoryEntry[] = [];
+    let offset = 4;
+    for (let i = 0; i < count; i++) {
+      if (offset + 13 > payload.length) break;
+      const timestamp = Number(view.getBigUint64(offset));
+      const format = view.getUint8(offset + 8);
+      const length = view.getUint32(offset + 9);
+      offset += 13;
+      if (offset + length > payload.length) break;
+      const bytes = payload.subarray(offset, offset + length);
+      offset += length;
+
+      if (format === 1) {
+        const message = parseNamedBinary(bytes);
+        if (message) entries.push({ timestamp, message });
+      } else {
+        try {
+          const message = JSON.parse(decoder.decode(bytes));
+          if (isWebSocketMessage(message)) {
+            entries.push({ timestamp, message: message as SignalValueWebSocketMessage });
+          }
+        } catch (err) {
+          console.error('Invalid JSON in history entry:', err);
+        }
+      }
+    }
+
+    handleCallbacks(history.signal, { type: 'history', signal: history.signal, entries });
+  };
+
+  // Batch payload: count(4), count * (format(1, 0 = text, 1 = binary), length(4), message)
+  // Values committed together on the server, each entry is dispatched as if it arrived on its own.
+  const handleBatchMessage = (data: Uint8Array) => {
+    const batch = parseNamedBinary(data);
+    if (!batch) return;
+
+    const payload = batch.payload;
+    const view = new DataView(payload.buffer, payload.byteOffset, payload.byteLength);
+    const count = view.getUint32(0);
+    const decoder = new TextDecoder('utf-8');
+    let offset = 4;
+    for (let i = 0; i < count; i++) {
+      if (offset + 5 > payload.length) break;
+      const format = view.getUint8(offset);
+      const length = view.getUint32(offset + 1);
+      offset += 5;
+      if (offset + length > payload.length) break;
+      const bytes = payload.subarray(offset, offset + length);
+      offset += length;
+
+      if (format === 1) {
+        handleBlobMessage(bytes);
+      } else {
+        handleTextMessage(decoder.decode(bytes));
+      }
+    }
   };
 
   const handleTextMessage = (textData: string) => {
@@ -275,6 +386,10 @@ export const WebSocketProvider: React.FC<WebSocketProviderProps> = ({ url, child
     }
   };
 
+  const requestHistory = (signal: string, range: { from?: number; to?: number; last?: number }) => {
+    sendMessage({ type: 'signal history request message', signal, ...range });
+  };
+
   const subscribe = (signal: string, callback: (message: WebSocketMessage) => void) => {
     let signalSubscribers = subscribers.current.get(signal);
     if (!signalSubscribers) {
@@ -320,7 +435,7 @@ export const WebSocketProvider: React.FC<WebSocketProviderProps> = ({ url, child
   }, [url]);
 
   return (
-    <WebSocketContext.Provider value={{ socket, sendMessage, subscribe, unsubscribe, onOpen, removeOnOpen, isOpen }}>
+    <WebSocketContext.Provider value={{ socket, sendMessage, subscribe, unsubscribe, onOpen, removeOnOpen, isOpen, requestHistory }}>
       {children}
     </WebSocketContext.Provider>
   );
@@ -0,0 +1,22 @@
+// Band vector payload: timestamp(8), format(1, 0 = uint8, 1 = float32), count(2), count * value
+// Labels are not in the payload, they arrive once per subscription in a 'signal layout message'.
+export const BAND_VECTOR_PAYLOAD_TYPE = 6;
+
+export function decodeBandVector(payload: Uint8Array): number[] | null {
+    const HEADER_LENGTH = 8 + 1 + 2;
+    if (payload.length < HEADER_LENGTH) return null;
+
+    const view = new DataView(payload.buffer, payload.byteOffset, payload.byteLength);
+    const format = view.getUint8(8);
+    const count = view.getUint16(9);
+    const valueSize = format === 1 ? 4 : 1;
+    if (payload.length < HEADER_LENGTH + count * valueSize) return null;
+
+    const values = new Array<number>(count);
+    for (let i = 0; i < count; i++) {
+        values[i] = format === 1
+            ? view.getFloat32(HEADER_LENGTH + i * 4)
+            : view.getUint8(HEADER_LENGTH + i) / 255;
+    }
+    return values;
+}